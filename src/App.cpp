@@ -227,6 +227,7 @@ App::App(int argc, char **argv) {
     CharInit();
     PollTheSplasher();
     BeatMatchInit();
+    BeatMatchDebugInit();
     PollTheSplasher();
     TrackInit();
     PollTheSplasher();
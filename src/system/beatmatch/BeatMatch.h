@@ -1,3 +1,5 @@
 #pragma once
 
 void BeatMatchInit();
+/** Register the beatmatch debug commands. Does nothing outside debug builds. */
+void BeatMatchDebugInit();
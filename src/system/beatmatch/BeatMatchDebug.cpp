@@ -0,0 +1,133 @@
+#include "beatmatch/BeatMatch.h"
+#include "beatmatch/ChartValidator.h"
+#include "beatmatch/FillInfo.h"
+#include "beatmatch/FillLookup.h"
+#include "math/Rand.h"
+#include "midi/Midi.h"
+#include "obj/Data.h"
+#include "obj/DataFunc.h"
+#include "os/Debug.h"
+#include "os/Timer.h"
+#include "utl/FileStream.h"
+#include "utl/MemStream.h"
+#include "utl/TextFileStream.h"
+
+#ifdef MILO_DEBUG
+namespace {
+    class MidiEventCounter : public MidiReceiver {
+    public:
+        MidiEventCounter() : mNumEvents(0) {}
+        virtual void OnNewTrack(int) {}
+        virtual void OnEndOfTrack() {}
+        virtual void OnAllTracksRead() {}
+        virtual void OnMidiMessage(int, unsigned char, unsigned char, unsigned char) {
+            mNumEvents++;
+        }
+        virtual void OnText(int, const char *, unsigned char) { mNumEvents++; }
+
+        int mNumEvents;
+    };
+}
+
+// (test_fill_lookup iterations) - compares the FillLookup searches against
+// FillInfo's linear scans over random fill sets, returns the number of mismatches
+static DataNode OnTestFillLookup(DataArray *a) {
+    int iterations = a->Size() > 1 ? a->Int(1) : 100;
+    int failures = 0;
+    for (int iter = 0; iter < iterations; iter++) {
+        FillInfo info;
+        int tick = RandomInt(0, 480);
+        int num = RandomInt(0, 40);
+        for (int i = 0; i < num; i++) {
+            int len = RandomInt(0, 1920);
+            // back to back fills are allowed, overlapping ones are rejected
+            info.AddFill(tick, len, false);
+            tick += len + RandomInt(-480, 960);
+        }
+        for (int q = 0; q < 200; q++) {
+            int t = RandomInt(-10, tick + 2000);
+            FillExtent found(-1, -1, false);
+            FillExtent expected(-1, -1, false);
+            bool hasFound = NextFillExtent(info, t, found);
+            bool hasExpected = info.NextFillExtents(t, expected);
+            if (hasFound != hasExpected || found.start != expected.start
+                || found.end != expected.end) {
+                MILO_LOG("fill lookup mismatch: next at %d\n", t);
+                failures++;
+            }
+            found = FillExtent(-1, -1, false);
+            expected = FillExtent(-1, -1, false);
+            hasFound = FillExtentAtOrBeforeTick(info, t, found);
+            hasExpected = info.FillExtentAtOrBefore(t, expected);
+            if (hasFound != hasExpected || found.start != expected.start
+                || found.end != expected.end) {
+                MILO_LOG("fill lookup mismatch: at or before %d\n", t);
+                failures++;
+            }
+        }
+    }
+    MILO_LOG("test_fill_lookup: %d iterations, %d failures\n", iterations, failures);
+    return failures;
+}
+
+// (validate_charts pattern out_file) - e.g. (validate_charts "songs/*.mid" "charts.json")
+static DataNode OnValidateCharts(DataArray *a) {
+    ChartValidator validator;
+    validator.AddCharts(a->Str(1));
+    validator.Run();
+    TextFileStream out(a->Str(2), false);
+    validator.WriteJson(out);
+    MILO_LOG(
+        "validate_charts: %d charts in %.1f ms (%.2f charts/s)\n",
+        validator.mResults.size(),
+        validator.mTotalMs,
+        validator.ChartsPerSecond()
+    );
+    return (int)validator.mResults.size();
+}
+
+// (bench_midi_read file iterations) - times MidiReader over a .mid already in
+// memory, the way SongData hands it to SongParser
+static DataNode OnBenchMidiRead(DataArray *a) {
+    const char *file = a->Str(1);
+    int iterations = a->Size() > 2 ? a->Int(2) : 20;
+    MemStream ms;
+    {
+        FileStream fs(file, FileStream::kRead, false);
+        if (fs.Fail()) {
+            MILO_WARN("bench_midi_read: could not open %s", file);
+            return 0;
+        }
+        ms.Resize(fs.Size());
+        fs.Read((void *)ms.Buffer(), fs.Size());
+    }
+    int numEvents = 0;
+    Timer timer;
+    timer.Restart();
+    for (int i = 0; i < iterations; i++) {
+        MidiEventCounter counter;
+        ms.Seek(0, BinStream::kSeekBegin);
+        MidiReader reader(ms, counter, file);
+        reader.ReadAllTracks();
+        numEvents = counter.mNumEvents;
+    }
+    float totalMs = timer.SplitMs();
+    MILO_LOG(
+        "bench_midi_read: %s, %d bytes, %d events: %.2f ms per read, %.0f events/s\n",
+        file,
+        ms.BufferSize(),
+        numEvents,
+        totalMs / iterations,
+        totalMs > 0 ? numEvents * iterations * 1000.0f / totalMs : 0.0f
+    );
+    return totalMs / iterations;
+}
+#endif
+
+void BeatMatchDebugInit() {
+#ifdef MILO_DEBUG
+    DataRegisterFunc("test_fill_lookup", OnTestFillLookup);
+    DataRegisterFunc("validate_charts", OnValidateCharts);
+    DataRegisterFunc("bench_midi_read", OnBenchMidiRead);
+#endif
+}
@@ -4,6 +4,7 @@
 #include "beatmatch/DrumMap.h"
 #include "beatmatch/DrumPlayer.h"
 #include "beatmatch/FillInfo.h"
+#include "beatmatch/FillLookup.h"
 #include "beatmatch/GameGemList.h"
 #include "beatmatch/InternalSongParserSink.h"
 #include "beatmatch/MercurySwitchFilter.h"
@@ -13,10 +14,12 @@
 #include "beatmatch/TrackType.h"
 #include "beatmatch/TrackWatcher.h"
 #include "decomp.h"
+#include "math/Utl.h"
 #include "game/Player.h"
 #include "obj/Data.h"
 #include "obj/Dir.h"
 #include "os/Debug.h"
+#include "os/Timer.h"
 #include "utl/MakeString.h"
 #include <climits>
 
@@ -38,8 +41,11 @@ BeatMatcher::BeatMatcher(
       mRawMercurySwitchState(0), mMercurySwitchState(0), mForceMercurySwitch(0),
       mSyncOffset(0), mDrivingPitchBendExternally(0), mFillStartTick(0x7fffffff),
       mLastFillEndTick(-1), mCodaStartTick(-1), mAutoplay(0), mForceFill(0), mNoFills(0),
-      mFillAudio(1), mEnableWhammy(1), mEnableCapStrip(1) {
+      mFillAudio(1), mEnableWhammy(1), mEnableCapStrip(1), mBufferInput(0),
+      mDrainingInput(0), mLogInputLatency(0), mNowStamp(0), mLastDrainTime(0) {
     mSongData->AddBeatMatcher(this);
+    arr->FindData("buffer_input", mBufferInput, false);
+    arr->FindData("log_input_latency", mLogInputLatency, false);
     DataArray *filterArr = arr->FindArray("mercury_switch_filter", false);
     if (filterArr) {
         mMercurySwitchFilter = NewMercurySwitchFilter(filterArr->Array(1));
@@ -54,7 +60,11 @@ void BeatMatcher::PostDynamicAdd(int i, float f) {
     ResetGemStates(f);
 }
 
-void BeatMatcher::Leave() { mAudio->ResetTrack(mCurTrack, false); }
+void BeatMatcher::Leave() {
+    mAudio->ResetTrack(mCurTrack, false);
+    if (mLogInputLatency)
+        DumpInputLatency();
+}
 
 BeatMatcher::~BeatMatcher() {
     mSongData->RemoveBeatMatcher(this);
@@ -93,8 +103,11 @@ void BeatMatcher::RegisterSink(BeatMatchSink &sink) { mSink = &sink; }
 
 void BeatMatcher::Poll(float f) {
     SetNow(f);
+    TIMER_GET_CYCLES(stamp);
+    mNowStamp = stamp;
     if (mController)
         mController->Poll();
+    DrainInput();
     CheckMercurySwitch(mNow);
     mWatcher->Poll(f);
 }
@@ -102,6 +115,8 @@ void BeatMatcher::Poll(float f) {
 void BeatMatcher::Jump(float f) {
     if (mNow != f) {
         SetNow(f);
+        mInputRing.Clear();
+        mLastDrainTime = f;
         mLastSwing = 0;
         mLastVelocityBucket = 0;
         mLastReleaseSwing = 0;
@@ -123,6 +138,8 @@ void BeatMatcher::ResetGemStates(float f) {
 }
 
 void BeatMatcher::FretButtonDown(int i1, int i2) {
+    if (QueueInput(kInputFretButtonDown, i1, i2, 0, kGemHitFlagNone))
+        return;
     if (!mAutoplay) {
         MILO_ASSERT(mSink, 0xCF);
         mSink->FretButtonDown(i1, mNow);
@@ -143,6 +160,8 @@ void BeatMatcher::FretButtonDown(int i1, int i2) {
 }
 
 void BeatMatcher::RGFretButtonDown(int iii) {
+    if (QueueInput(kInputRGFretButtonDown, iii, 0, 0, kGemHitFlagNone))
+        return;
     if (!mAutoplay) {
         GameGemList *gemList = mSongData->GetGemList(mCurTrack);
         if (!gemList->Empty()) {
@@ -153,6 +172,8 @@ void BeatMatcher::RGFretButtonDown(int iii) {
 }
 
 void BeatMatcher::FretButtonUp(int i1) {
+    if (QueueInput(kInputFretButtonUp, i1, 0, 0, kGemHitFlagNone))
+        return;
     if (!mAutoplay) {
         MILO_ASSERT(mSink, 0xF1);
         mSink->FretButtonUp(i1, mNow);
@@ -172,6 +193,12 @@ void BeatMatcher::FretButtonUp(int i1) {
 }
 
 bool BeatMatcher::Swing(int i1, bool b2, bool b3, bool b4, bool b5, GemHitFlags flags) {
+    // a queued swing reports success so the controller doesn't send its own
+    // fallback; DispatchInput sends it instead if the swing misses
+    int inputFlags = (b2 ? kInputFlagArg1 : 0) | (b3 ? kInputFlagArg2 : 0)
+        | (b4 ? kInputFlagArg3 : 0) | (b5 ? kInputFlagArg4 : 0);
+    if (QueueInput(kInputSwing, i1, 0, inputFlags, flags))
+        return true;
     if (mAutoplay || mSongData->GetGemList(mCurTrack)->Empty())
         return false;
     else {
@@ -224,10 +251,18 @@ bool BeatMatcher::Swing(int i1, bool b2, bool b3, bool b4, bool b5, GemHitFlags
     }
 }
 
-void BeatMatcher::ReleaseSwing() { mLastReleaseSwing = mNow; }
+void BeatMatcher::ReleaseSwing() {
+    if (QueueInput(kInputReleaseSwing, 0, 0, 0, kGemHitFlagNone))
+        return;
+    mLastReleaseSwing = mNow;
+}
+
 void BeatMatcher::OutOfRangeSwing() { mSink->OutOfRangeSwing(); }
 
 void BeatMatcher::NonStrumSwing(int i1, bool b2, bool b3) {
+    int inputFlags = (b2 ? kInputFlagArg1 : 0) | (b3 ? kInputFlagArg2 : 0);
+    if (QueueInput(kInputNonStrumSwing, i1, 0, inputFlags, kGemHitFlagNone))
+        return;
     if (mAutoplay || mSongData->GetGemList(mCurTrack)->Empty())
         return;
     mWatcher->NonStrumSwing(i1, b2, b3);
@@ -460,7 +495,7 @@ void BeatMatcher::SetFillsEnabled(bool b) {
         if (i2 != INT_MAX) {
             int tick = mSongPos.GetTotalTick();
             FillExtent ext(-1, -1, false);
-            if (mSongData->GetFillInfo(mCurTrack)->FillExtentAtOrBefore(tick, ext)) {
+            if (FillExtentAtOrBeforeTick(*mSongData->GetFillInfo(mCurTrack), tick, ext)) {
                 mLastFillEndTick = ext.end;
             }
         }
@@ -478,7 +513,7 @@ void BeatMatcher::SetFillsEnabled(int i1, bool b2) {
         FillExtent ext(0, 0, false);
         int i28 = 0;
         i1 = mSongData->GetTempoMap()->GetLoopTick(i1, i28);
-        if (mSongData->GetFillInfo(mCurTrack)->NextFillExtents(i1, ext)) {
+        if (NextFillExtent(*mSongData->GetFillInfo(mCurTrack), i1, ext)) {
             i1 = ext.start + i28;
         }
     }
@@ -549,3 +584,94 @@ void BeatMatcher::SetNow(float f) {
     mSongPos = mSongData->CalcSongPos(f);
     mTick = mSongPos.GetTotalTick();
 }
+
+void BeatMatcher::SetBufferInput(bool b) {
+    if (!b)
+        DrainInput();
+    mBufferInput = b;
+}
+
+bool BeatMatcher::QueueInput(
+    BeatMatchInputEventType type, int slot, int arg, int flags, GemHitFlags hitFlags
+) {
+    if (!mBufferInput || mDrainingInput || mAutoplay)
+        return false;
+    BeatMatchInputEvent ev;
+    TIMER_GET_CYCLES(stamp);
+    ev.mStamp = stamp;
+    ev.mType = type;
+    ev.mFlags = flags;
+    ev.mSlot = slot;
+    ev.mArg = arg;
+    ev.mHitFlags = hitFlags;
+    // if the ring is full, judge at poll time rather than lose the input
+    return mInputRing.Push(ev);
+}
+
+void BeatMatcher::DrainInput() {
+    float pollNow = mNow;
+    if (!mInputRing.Empty()) {
+        mDrainingInput = true;
+        float lastTime = mLastDrainTime;
+        BeatMatchInputEvent ev;
+        while (mInputRing.Pop(ev)) {
+            // convert the capture stamp into song time relative to this poll,
+            // never earlier than what the watcher has already been polled past
+            int age = mNowStamp - ev.mStamp;
+            float evTime = age > 0 ? pollNow - Timer::CyclesToMs(age) : pollNow;
+            evTime = Clamp(lastTime, pollNow, evTime);
+            lastTime = evTime;
+            SetNow(evTime);
+            DispatchInput(ev);
+            TIMER_GET_CYCLES(judged);
+            mInputLatency.Add(Timer::CyclesToMs(judged - ev.mStamp));
+        }
+        SetNow(pollNow);
+        mDrainingInput = false;
+    }
+    mLastDrainTime = pollNow;
+}
+
+void BeatMatcher::DispatchInput(const BeatMatchInputEvent &ev) {
+    switch (ev.mType) {
+    case kInputFretButtonDown:
+        FretButtonDown(ev.mSlot, ev.mArg);
+        break;
+    case kInputFretButtonUp:
+        FretButtonUp(ev.mSlot);
+        break;
+    case kInputRGFretButtonDown:
+        RGFretButtonDown(ev.mSlot);
+        break;
+    case kInputSwing:
+        if (!Swing(
+                ev.mSlot,
+                ev.Flag(kInputFlagArg1),
+                ev.Flag(kInputFlagArg2),
+                ev.Flag(kInputFlagArg3),
+                ev.Flag(kInputFlagArg4),
+                ev.mHitFlags
+            )
+            && ev.Flag(kInputFlagArg3)) {
+            // solo button swing missed, controllers fall back to a hopo
+            NonStrumSwing(ev.mSlot, true, true);
+        }
+        break;
+    case kInputReleaseSwing:
+        ReleaseSwing();
+        break;
+    case kInputNonStrumSwing:
+        NonStrumSwing(ev.mSlot, ev.Flag(kInputFlagArg1), ev.Flag(kInputFlagArg2));
+        break;
+    default:
+        MILO_FAIL("Bad input event type %d\n", ev.mType);
+        break;
+    }
+}
+
+void BeatMatcher::DumpInputLatency() const {
+    mInputLatency.Dump(MakeString("player %d", mPlayerSlot));
+    if (mInputRing.NumDropped() != 0) {
+        MILO_LOG("  %d events dropped\n", mInputRing.NumDropped());
+    }
+}
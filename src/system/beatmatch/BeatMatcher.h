@@ -3,6 +3,7 @@
 #include "beatmatch/BeatMatchControllerSink.h"
 #include "beatmatch/BeatMatchSink.h"
 #include "beatmatch/DrumPlayer.h"
+#include "beatmatch/InputEventRing.h"
 #include "beatmatch/MasterAudio.h"
 #include "beatmatch/TrackType.h"
 #include "beatmatch/TrackWatcher.h"
@@ -103,6 +104,12 @@ public:
     void SetFillAudio(bool audio) { mFillAudio = audio; }
     int GetFillStartTick() const { return mFillStartTick; }
     int CurrentTrack() const { return mCurTrack; }
+    void SetBufferInput(bool);
+    void DumpInputLatency() const;
+    const InputLatencyHistogram &GetInputLatency() const { return mInputLatency; }
+    bool QueueInput(BeatMatchInputEventType, int, int, int, GemHitFlags);
+    void DrainInput();
+    void DispatchInput(const BeatMatchInputEvent &);
 
     bool mWaitingForAudio; // 0x8
     UserGuid mUserGuid; // 0xc
@@ -145,4 +152,13 @@ public:
     FillLogic mFillLogic; // 0xb4
     bool mEnableWhammy; // 0xb8
     bool mEnableCapStrip; // 0xb9
+    /** Queue sink input and judge it at capture time. Off unless the beatmatcher
+     * config sets buffer_input. */
+    bool mBufferInput;
+    bool mDrainingInput;
+    bool mLogInputLatency;
+    unsigned int mNowStamp; // timebase at the last SetNow from Poll
+    float mLastDrainTime;
+    InputEventRing mInputRing;
+    InputLatencyHistogram mInputLatency;
 };
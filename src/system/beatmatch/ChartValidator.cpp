@@ -0,0 +1,225 @@
+#include "beatmatch/ChartValidator.h"
+#include "beatmatch/BeatMatchUtl.h"
+#include "beatmatch/GameGem.h"
+#include "beatmatch/GameGemList.h"
+#include "beatmatch/Phrase.h"
+#include "beatmatch/PhraseAnalyzer.h"
+#include "beatmatch/PlayerTrackConfig.h"
+#include "beatmatch/SongData.h"
+#include "obj/Data.h"
+#include "os/Debug.h"
+#include "os/File.h"
+#include "os/System.h"
+#include "os/Timer.h"
+#include "utl/SongInfoCopy.h"
+#include <vector>
+
+#ifdef MILO_DEBUG
+namespace {
+    // gems in a row needed for each multiplier step
+    const int kGemsPerMultiplier = 10;
+    // widest fret span a real guitar chord can ask for
+    const int kMaxRGFretSpan = 5;
+
+    std::vector<String> *gCollectingCharts;
+
+    void CollectChart(const char *dir, const char *file) {
+        String path(MakeString("%s/%s", dir, file));
+        path.ReplaceAll('\\', '/');
+        gCollectingCharts->push_back(path);
+    }
+
+    bool IsRealStringTrack(TrackType type) {
+        return type == kTrackRealGuitar || type == kTrackRealGuitar22Fret
+            || type == kTrackRealBass || type == kTrackRealBass22Fret;
+    }
+
+    bool CheckRGChord(const GameGem &gem, TrackType type) {
+        int maxFret = (type == kTrackRealGuitar22Fret || type == kTrackRealBass22Fret)
+            ? 22
+            : 17;
+        int lowest = maxFret + 1;
+        int highest = 0;
+        bool anyString = false;
+        for (unsigned int i = 0; i < 6; i++) {
+            int fret = gem.GetFret(i);
+            if (fret < 0)
+                continue;
+            anyString = true;
+            if (fret > maxFret)
+                return false;
+            if (fret > 0) {
+                MinEq(lowest, fret);
+                MaxEq(highest, fret);
+            }
+        }
+        if (!anyString)
+            return false;
+        return highest == 0 || highest - lowest <= kMaxRGFretSpan;
+    }
+}
+
+ChartValidator::ChartValidator() : mTotalMs(0) {}
+
+void ChartValidator::AddCharts(const char *pattern) {
+    char buf[256];
+    strcpy(buf, pattern);
+    gCollectingCharts = &mFiles;
+    FileRecursePattern(buf, CollectChart, false);
+    gCollectingCharts = nullptr;
+}
+
+void ChartValidator::AddChart(const char *file) { mFiles.push_back(file); }
+
+void ChartValidator::Run() {
+    Timer timer;
+    timer.Restart();
+    mResults.clear();
+    mResults.resize(mFiles.size());
+    for (int i = 0; i < mFiles.size(); i++) {
+        AnalyzeChart(mFiles[i].c_str(), mResults[i]);
+    }
+    mTotalMs = timer.SplitMs();
+}
+
+float ChartValidator::ChartsPerSecond() const {
+    return mTotalMs > 0 ? mResults.size() * 1000.0f / mTotalMs : 0;
+}
+
+void ChartValidator::AnalyzeChart(const char *file, ChartStats &stats) {
+    stats.mFile = file;
+    // SongData finds the midi from the base file name
+    String base(file);
+    unsigned int ext = base.rfind(".mid");
+    if (ext != String::npos)
+        base = base.substr(0, ext);
+    if (!FileExists(MakeString("%s.mid", base.c_str()), 0)) {
+        MILO_WARN("%s: could not find chart", file);
+        return;
+    }
+
+    Timer timer;
+    timer.Restart();
+    SongInfoCopy info;
+    info.mName = FileGetBase(file, 0);
+    info.mBaseFileName = base;
+    PlayerTrackConfigList configs(0);
+    std::vector<MidiReceiver *> receivers;
+    SongData *data = new SongData();
+    // easy through expert
+    data->Load(&info, 4, &configs, receivers, true, kSongData_NoValidation);
+    stats.mLoadMs = timer.SplitMs();
+    stats.mLoaded = true;
+    stats.mPhraseErrors = data->GetPhraseAnalyzer()->Verify();
+    stats.mTracks.resize(data->GetNumTracks());
+    for (int i = 0; i < data->GetNumTracks(); i++) {
+        AnalyzeTrack(*data, i, stats.mTracks[i]);
+    }
+    delete data;
+}
+
+void ChartValidator::AnalyzeTrack(SongData &data, int track, ChartTrackStats &stats) {
+    TrackType type = data.TrackTypeAt(track);
+    stats.mName = data.TrackName(track);
+    stats.mType = type;
+    if (type == kTrackVocals)
+        return;
+
+    Symbol typeSym = TrackTypeToSym(type);
+    DataArray *points = SystemConfig("scoring", "points")->FindArray(typeSym, false);
+    DataArray *cutoffs = SystemConfig("scoring", "star_ratings")
+                             ->FindArray("new_instrument_thresholds")
+                             ->FindArray(typeSym, false);
+    int head = points ? points->FindInt("head") : 0;
+    int tail = points ? points->FindInt("tail") : 0;
+    int chord = points ? points->FindInt("chord") : 0;
+    // same multiplier caps as MultiplayerAnalyzer::AddTrack
+    int maxMultiplier = (type == kTrackBass || type == kTrackRealBass
+                         || type == kTrackRealBass22Fret)
+        ? 6
+        : 4;
+    if (type == kTrackDrum && points) {
+        head += points->FindInt("pro_bonus");
+    }
+
+    PhraseDB *phrases = data.mPhraseDBs[track];
+    stats.mDifficulties.resize(data.GetNumDifficulties());
+    for (int diff = 0; diff < data.GetNumDifficulties(); diff++) {
+        ChartDifficultyStats &diffStats = stats.mDifficulties[diff];
+        diffStats.mOverdrivePhrases =
+            phrases->GetPhraseList(diff, kCommonPhrase).mPhrases.size();
+        diffStats.mSoloPhrases =
+            phrases->GetPhraseList(diff, kSoloPhrase).mPhrases.size();
+
+        // perfect autoplay: every gem hit, every sustain held to the end
+        GameGemList *gems = data.GetGemListByDiff(track, diff);
+        float base = 0;
+        float score = 0;
+        diffStats.mNumGems = gems->NumGems();
+        for (int i = 0; i < gems->NumGems(); i++) {
+            const GameGem &gem = gems->GetGem(i);
+            int slots = GemNumSlots(gem.GetSlots());
+            int gemPoints = head;
+            if (slots > 1) {
+                gemPoints = chord > 0 ? chord : head * slots;
+            }
+            float tailPoints = 0;
+            if (!gem.IgnoreDuration()) {
+                tailPoints = (float)(tail * gem.GetDurationTicks()) / 480.0f * slots;
+            }
+            int multiplier = Min(i / kGemsPerMultiplier + 1, maxMultiplier);
+            base += gemPoints + tailPoints;
+            score += (gemPoints + tailPoints) * multiplier;
+            if (IsRealStringTrack(type) && !CheckRGChord(gem, type)) {
+                diffStats.mRGChordErrors++;
+            }
+        }
+        diffStats.mBasePoints = base;
+        diffStats.mMaxScore = score;
+
+        diffStats.mStarCutoffs.push_back(0);
+        if (cutoffs) {
+            for (int i = 1; i < cutoffs->Size(); i++) {
+                diffStats.mStarCutoffs.push_back(cutoffs->Float(i) * score);
+            }
+        }
+    }
+}
+
+void ChartValidator::WriteJson(TextStream &ts) const {
+    ts << "{\n  \"num_charts\": " << (int)mResults.size() << ",\n";
+    ts << "  \"total_ms\": " << mTotalMs << ",\n";
+    ts << "  \"charts_per_second\": " << ChartsPerSecond() << ",\n";
+    ts << "  \"charts\": [";
+    for (int i = 0; i < mResults.size(); i++) {
+        const ChartStats &chart = mResults[i];
+        ts << (i == 0 ? "\n" : ",\n") << "    {\"file\": \"" << chart.mFile.c_str()
+           << "\", \"loaded\": " << (chart.mLoaded ? "true" : "false")
+           << ", \"load_ms\": " << chart.mLoadMs
+           << ", \"phrase_errors\": " << chart.mPhraseErrors << ", \"tracks\": [";
+        for (int j = 0; j < chart.mTracks.size(); j++) {
+            const ChartTrackStats &track = chart.mTracks[j];
+            ts << (j == 0 ? "\n" : ",\n") << "      {\"name\": \"" << track.mName.Str()
+               << "\", \"type\": \"" << TrackTypeToSym(track.mType).Str()
+               << "\", \"difficulties\": [";
+            for (int k = 0; k < track.mDifficulties.size(); k++) {
+                const ChartDifficultyStats &diff = track.mDifficulties[k];
+                ts << (k == 0 ? "" : ", ") << "{\"gems\": " << diff.mNumGems
+                   << ", \"overdrive_phrases\": " << diff.mOverdrivePhrases
+                   << ", \"solo_phrases\": " << diff.mSoloPhrases
+                   << ", \"base_points\": " << diff.mBasePoints
+                   << ", \"max_score\": " << diff.mMaxScore
+                   << ", \"rg_chord_errors\": " << diff.mRGChordErrors
+                   << ", \"star_cutoffs\": [";
+                for (int n = 0; n < diff.mStarCutoffs.size(); n++) {
+                    ts << (n == 0 ? "" : ", ") << diff.mStarCutoffs[n];
+                }
+                ts << "]}";
+            }
+            ts << "]}";
+        }
+        ts << (chart.mTracks.empty() ? "]}" : "\n    ]}");
+    }
+    ts << "\n  ]\n}\n";
+}
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+#include "beatmatch/TrackType.h"
+#include "utl/Str.h"
+#include "utl/Symbol.h"
+#include "utl/TextStream.h"
+#include <vector>
+
+class SongData;
+
+/** The results of a perfect run through one difficulty of a track. */
+struct ChartDifficultyStats {
+    ChartDifficultyStats()
+        : mNumGems(0), mOverdrivePhrases(0), mSoloPhrases(0), mBasePoints(0),
+          mMaxScore(0), mRGChordErrors(0) {}
+
+    int mNumGems;
+    int mOverdrivePhrases;
+    int mSoloPhrases;
+    /** Sum of gem head, tail and chord points, before any multiplier. */
+    int mBasePoints;
+    /** Points for hitting every gem with a full streak, without overdrive. */
+    int mMaxScore;
+    /** Solo star cutoffs against mMaxScore, starting with 0 stars. */
+    std::vector<int> mStarCutoffs;
+    /** Real guitar/bass chords with no strings, impossible frets or spans. */
+    int mRGChordErrors;
+};
+
+struct ChartTrackStats {
+    Symbol mName;
+    TrackType mType;
+    std::vector<ChartDifficultyStats> mDifficulties;
+};
+
+struct ChartStats {
+    ChartStats() : mLoaded(false), mLoadMs(0), mPhraseErrors(0) {}
+
+    String mFile;
+    bool mLoaded;
+    float mLoadMs;
+    /** Overdrive phrases missing from instruments that should share them. */
+    int mPhraseErrors;
+    std::vector<ChartTrackStats> mTracks;
+};
+
+/**
+ * @brief Batch chart checker.
+ *
+ * Loads every .mid matching a file pattern through SongData, scores a perfect
+ * run of each track and difficulty, and reports phrase and real guitar chord
+ * problems as JSON, so a song library can be checked without playing it.
+ * Only built into debug builds, for the validate_charts command.
+ */
+class ChartValidator {
+public:
+    ChartValidator();
+
+    /** Queue every file matching the pattern, e.g. "songs/*.mid". */
+    void AddCharts(const char *pattern);
+    void AddChart(const char *file);
+    /** Load and score every queued chart. */
+    void Run();
+    void WriteJson(TextStream &) const;
+    float ChartsPerSecond() const;
+
+    static void AnalyzeChart(const char *file, ChartStats &stats);
+    static void AnalyzeTrack(SongData &data, int track, ChartTrackStats &stats);
+
+    std::vector<String> mFiles;
+    std::vector<ChartStats> mResults;
+    float mTotalMs;
+};
@@ -0,0 +1,34 @@
+#include "beatmatch/FillLookup.h"
+#include <algorithm>
+
+namespace {
+    bool FillStartsBefore(const FillExtent &ext, int tick) { return ext.start < tick; }
+    bool TickBeforeFillStart(int tick, const FillExtent &ext) { return tick < ext.start; }
+}
+
+bool NextFillExtent(const FillInfo &info, int tick, FillExtent &outExtent) {
+    std::vector<FillExtent>::const_iterator it = std::lower_bound(
+        info.mFills.begin(), info.mFills.end(), tick, FillStartsBefore
+    );
+    if (it == info.mFills.end())
+        return false;
+    else {
+        outExtent.start = it->start;
+        outExtent.end = it->end;
+        return true;
+    }
+}
+
+bool FillExtentAtOrBeforeTick(const FillInfo &info, int tick, FillExtent &outExtent) {
+    std::vector<FillExtent>::const_iterator it = std::upper_bound(
+        info.mFills.begin(), info.mFills.end(), tick, TickBeforeFillStart
+    );
+    if (it == info.mFills.begin())
+        return false;
+    else {
+        --it;
+        outExtent.start = it->start;
+        outExtent.end = it->end;
+        return true;
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "beatmatch/FillInfo.h"
+
+/** Get the next coming FillExtent relative to the supplied tick.
+ * Same result as FillInfo::NextFillExtents, but a binary search, since
+ * FillInfo::AddFill keeps mFills sorted and non-overlapping.
+ * @param [in] info The fills to search.
+ * @param [in] tick The tick to check.
+ * @param [out] outExtent The first FillExtent starting at or after this tick.
+ * @returns True if a FillExtent exists at or after the supplied tick, false if not.
+ */
+bool NextFillExtent(const FillInfo &info, int tick, FillExtent &outExtent);
+
+/** Get the FillExtent either at or before the supplied tick.
+ * Same result as FillInfo::FillExtentAtOrBefore, but a binary search.
+ * @param [in] info The fills to search.
+ * @param [in] tick The tick to check.
+ * @param [out] outExtent The last FillExtent starting at or before this tick.
+ * @returns True if a FillExtent exists at or before the supplied tick, false if not.
+ */
+bool FillExtentAtOrBeforeTick(const FillInfo &info, int tick, FillExtent &outExtent);
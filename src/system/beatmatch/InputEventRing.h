@@ -0,0 +1,135 @@
+#pragma once
+#include "beatmatch/BeatMatchControllerSink.h"
+#include "os/Debug.h"
+#include "os/Timer.h"
+#include "decomp.h"
+
+enum BeatMatchInputEventType {
+    kInputFretButtonDown = 0,
+    kInputFretButtonUp = 1,
+    kInputRGFretButtonDown = 2,
+    kInputSwing = 3,
+    kInputReleaseSwing = 4,
+    kInputNonStrumSwing = 5
+};
+
+// bools passed through BeatMatchControllerSink::Swing/NonStrumSwing
+enum BeatMatchInputEventFlags {
+    kInputFlagArg1 = 0x1,
+    kInputFlagArg2 = 0x2,
+    kInputFlagArg3 = 0x4,
+    kInputFlagArg4 = 0x8
+};
+
+// One controller event, stamped with the timebase when it was captured
+struct BeatMatchInputEvent {
+    bool Flag(int flag) const { return mFlags & flag; }
+
+    unsigned int mStamp; // 0x0
+    unsigned char mType; // 0x4
+    unsigned char mFlags; // 0x5
+    short mSlot; // 0x6
+    int mArg; // 0x8
+    GemHitFlags mHitFlags; // 0xc
+};
+
+#define INPUT_RING_SIZE 64
+
+// Single producer/single consumer ring: the thread receiving controller input
+// pushes, BeatMatcher::Poll pops.  Indices only ever grow, and each side only
+// writes its own, so no lock is needed.
+class InputEventRing {
+public:
+    InputEventRing() : mHead(0), mTail(0), mDropped(0) {}
+
+    bool Push(const BeatMatchInputEvent &ev) {
+        unsigned int head = mHead;
+        if (head - mTail >= INPUT_RING_SIZE) {
+            mDropped++;
+            return false;
+        }
+        mEvents[head % INPUT_RING_SIZE] = ev;
+        // event must be visible before the consumer sees the new head
+        ASM_BLOCK(sync);
+        mHead = head + 1;
+        return true;
+    }
+
+    bool Pop(BeatMatchInputEvent &ev) {
+        unsigned int tail = mTail;
+        if (tail == mHead)
+            return false;
+        ev = mEvents[tail % INPUT_RING_SIZE];
+        ASM_BLOCK(sync);
+        mTail = tail + 1;
+        return true;
+    }
+
+    bool Empty() const { return mTail == mHead; }
+    int Size() const { return mHead - mTail; }
+    int NumDropped() const { return mDropped; }
+
+    // consumer side only
+    void Clear() { mTail = mHead; }
+
+private:
+    BeatMatchInputEvent mEvents[INPUT_RING_SIZE];
+    volatile unsigned int mHead;
+    volatile unsigned int mTail;
+    int mDropped;
+};
+
+#define NUM_LATENCY_BUCKETS 8
+
+// Power-of-two millisecond buckets: [0,1) [1,2) [2,4) ... [64,inf)
+class InputLatencyHistogram {
+public:
+    InputLatencyHistogram() { Clear(); }
+
+    void Clear() {
+        for (int i = 0; i < NUM_LATENCY_BUCKETS; i++) {
+            mBuckets[i] = 0;
+        }
+        mCount = 0;
+        mTotalMs = 0;
+        mMaxMs = 0;
+    }
+
+    void Add(float ms) {
+        int bucket = 0;
+        for (float limit = 1.0f; bucket < NUM_LATENCY_BUCKETS - 1 && ms >= limit;
+             limit *= 2.0f) {
+            bucket++;
+        }
+        mBuckets[bucket]++;
+        mCount++;
+        mTotalMs += ms;
+        if (ms > mMaxMs)
+            mMaxMs = ms;
+    }
+
+    void Dump(const char *name) const {
+        MILO_LOG(
+            "%s input latency: %d events, avg %.2f ms, max %.2f ms\n",
+            name,
+            mCount,
+            mCount ? mTotalMs / mCount : 0.0f,
+            mMaxMs
+        );
+        float low = 0;
+        for (int i = 0; i < NUM_LATENCY_BUCKETS; i++) {
+            float high = i == 0 ? 1.0f : low * 2.0f;
+            if (i == NUM_LATENCY_BUCKETS - 1) {
+                MILO_LOG("  %5.0f+      ms: %d\n", low, mBuckets[i]);
+            } else {
+                MILO_LOG("  %5.0f-%-5.0f ms: %d\n", low, high, mBuckets[i]);
+            }
+            low = high;
+        }
+    }
+
+    int mBuckets[NUM_LATENCY_BUCKETS];
+    int mCount;
+    float mTotalMs;
+    float mMaxMs;
+};
@@ -88,7 +88,8 @@ void PhraseAnalyzer::Analyze() {
     Verify();
 }
 
-void PhraseAnalyzer::Verify() const {
+int PhraseAnalyzer::Verify() const {
+    int numErrors = 0;
     int trackTypes = mSongData->GetTrackTypes();
     for (int i = 0; i < mPhrases.size(); i++) {
         int mask = mPhrases[i].unk4;
@@ -97,6 +98,7 @@ void PhraseAnalyzer::Verify() const {
             if (i10) {
                 int i3 = trackTypes & sEquivalentTrackTypes[j];
                 if (i10 != i3) {
+                    numErrors++;
                     i3 -= i10;
                     String str54;
                     String str60;
@@ -130,6 +132,7 @@ void PhraseAnalyzer::Verify() const {
             }
         }
     }
+    return numErrors;
 }
 
 int PhraseAnalyzer::NumPhrases() const {
@@ -2,6 +2,7 @@
 #include "beatmatch/BeatMatchSink.h"
 #include "beatmatch/BeatMatchUtl.h"
 #include "beatmatch/FillInfo.h"
+#include "beatmatch/FillLookup.h"
 #include "beatmatch/GameGem.h"
 #include "beatmatch/Output.h"
 #include "beatmatch/TrackType.h"
@@ -662,7 +663,9 @@ bool TrackWatcherImpl::IsFillCompletion(float ms, int tick, int &solo_end_tick)
         FillExtent extent(0, 0, 0);
         int i38 = 0;
         int loopTick = mSongData->GetTempoMap()->GetLoopTick(tick, i38);
-        if (mSongData->GetFillInfo(mTrack)->FillExtentAtOrBefore(loopTick, extent)) {
+        if (FillExtentAtOrBeforeTick(
+                *mSongData->GetFillInfo(mTrack), loopTick, extent
+            )) {
             float time = mSongData->GetTempoMap()->TickToTime(extent.end + i38);
             if (InSlopWindow(time, ms)) {
                 solo_end_tick = mSongData->GetTempoMap()->TimeToTick(time);
@@ -12,6 +12,7 @@
 #include "CharUpperTwist.h"
 #include "CharWeightSetter.h"
 #include "ClipCollide.h"
+#include "ClipGraphGen.h"
 #include "FileMergerOrganizer.h"
 #include "Waypoint.h"
 #include "char/CharClipGroup.h"
@@ -126,6 +127,7 @@ void CharInit() {
     FileMerger::Init();
     CharBoneDir::Register();
     ClipCollide::Init();
+    ClipGraphGenerator::Init();
     FileMergerOrganizer::Init();
     PreloadSharedSubdirs("char");
     CharBoneDir::Init();
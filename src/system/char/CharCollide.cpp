@@ -15,6 +15,8 @@ CharCollide::CharCollide() : mShape(kSphere), mFlags(0), mMesh(this, 0), mMeshYB
         unk_structs[i].vec.Zero();
     }
     unk148.Reset();
+    mBoundCenter.Zero();
+    mBoundRadius = 0;
 }
 
 CharCollide::~CharCollide() {}
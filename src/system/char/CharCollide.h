@@ -65,7 +65,27 @@ public:
         }
         if (mShape >= 3) {
             unk18c = 1.0f / (mCurLength[1] - mCurLength[0]);
+            // around the cigar's axis segment, plus its larger radius
+            ScaleAdd(
+                unk1a0, unk194, (mCurLength[0] + mCurLength[1]) * 0.5f, mBoundCenter
+            );
+            mBoundRadius = (mCurLength[1] - mCurLength[0]) * 0.5f * Length(unk194)
+                + Max(mCurRadius[0], mCurRadius[1]);
+        } else {
+            mBoundCenter = unk1a0;
+            mBoundRadius = mCurRadius[0];
         }
+        // so rounding never culls a sphere that GetRadius() says touches
+        mBoundRadius = mBoundRadius * 1.001f + 0.001f;
+    }
+
+    /**
+     * Whether a sphere of the given radius at pos could touch a sphere or
+     * cigar shape, as of the last SyncWorldState().
+     */
+    bool MayTouch(const Vector3 &pos, float radius) const {
+        float r = mBoundRadius + radius;
+        return DistanceSquared(pos, mBoundCenter) < r * r;
     }
 
     DECLARE_REVS;
@@ -100,6 +120,9 @@ public:
     float unk190;
     Vector3 unk194;
     Vector3 unk1a0;
+    /** World space bounding sphere of a sphere or cigar shape. */
+    Vector3 mBoundCenter; // 0x1ac
+    float mBoundRadius; // 0x1b8
 };
 
 struct ByRadius {
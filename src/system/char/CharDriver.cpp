@@ -17,6 +17,8 @@
 #include "obj/Task.h"
 #include "obj/Utl.h"
 #include "os/Debug.h"
+#include "os/System.h"
+#include "os/Timer.h"
 #include "rndobj/Highlightable.h"
 #include "rndobj/Poll.h"
 #include "utl/Symbols.h"
@@ -40,6 +42,210 @@ CharDriver::~CharDriver() {
     delete mInternalBones;
 }
 
+CharPoseCache TheCharPoseCache;
+
+namespace {
+    // blend weights closer than this share a pose
+    const float kPoseWeightSteps = 256;
+
+    int Quantize(float f, float steps) { return (int)std::floor(f * steps + 0.5f); }
+
+    unsigned int HashInt(unsigned int hash, unsigned int i) {
+        return (hash ^ i) * 16777619;
+    }
+}
+
+bool CharPoseCache::Key::operator<(const Key &key) const {
+    return memcmp(this, &key, sizeof(Key)) < 0;
+}
+
+bool CharPoseCache::MakeKey(
+    const CharDriver &driver, const CharBones &bones, float weight, Key &key
+) const {
+    // memset so the padding and unused clip slots compare equal
+    memset(&key, 0, sizeof(Key));
+    key.mClips = driver.mClips.Ptr();
+    key.mClipType = driver.mClipType.Str();
+    unsigned int layout = HashInt(2166136261, bones.mCompression);
+    for (int i = 0; i < CharBones::NUM_TYPES; i++) {
+        layout = HashInt(layout, bones.mCounts[i]);
+    }
+    for (int i = 0; i < bones.mBones.size(); i++) {
+        layout = HashInt(layout, (unsigned int)bones.mBones[i].name.Str());
+    }
+    key.mLayout = layout;
+    key.mWeight = Quantize(weight, kPoseWeightSteps);
+    key.mMultiple = driver.mPlayMultipleClips;
+    float beatSteps = 1 / mBeatStep;
+    for (CharClipDriver *it = driver.mFirst; it != nullptr; it = it->Next()) {
+        int n = key.mNumClips++;
+        if (n == kMaxKeyClips)
+            return false;
+        key.mClip[n] = it->GetClip();
+        key.mMultiple |= it->mPlayMultipleClips << (n + 1);
+        key.mBeat[n] = Quantize(it->mBeat, beatSteps);
+        key.mDBeat[n] = Quantize(it->mDBeat, beatSteps);
+        key.mBlendFrac[n] = Quantize(it->mBlendFrac, kPoseWeightSteps);
+    }
+    return true;
+}
+
+void CharPoseCache::ScaleAdd(CharDriver &driver, CharBones &bones, float weight) {
+    Key key;
+    if (mBeatStep <= 0 || !MakeKey(driver, bones, weight, key)) {
+        driver.mFirst->ScaleAdd(bones, weight);
+        return;
+    }
+    float frame = TheTaskMgr.UISeconds();
+    if (frame != mFrame) {
+        mPoses.clear();
+        mFrame = frame;
+    }
+#ifdef MILO_DEBUG
+    Timer timer;
+    timer.Restart();
+#endif
+    std::map<Key, Pose>::iterator found = mPoses.find(key);
+    if (found != mPoses.end()) {
+        const Pose &pose = found->second;
+        bool sameLayout = pose.mNames.size() == bones.mBones.size();
+        for (int i = 0; sameLayout && i < pose.mNames.size(); i++) {
+            sameLayout = pose.mNames[i] == bones.mBones[i].name.Str();
+        }
+        if (sameLayout) {
+            memcpy(bones.Start(), &pose.mData[0], bones.TotalSize());
+            for (int i = 0; i < bones.mBones.size(); i++) {
+                bones.mBones[i].weight = pose.mWeights[i];
+            }
+            int i = 0;
+            for (CharClipDriver *it = driver.mFirst; it != nullptr; it = it->Next()) {
+                it->mWeight = pose.mClipWeights[i++];
+            }
+#ifdef MILO_DEBUG
+            mHits++;
+            mHitMs += timer.SplitMs();
+#endif
+            return;
+        }
+        // a layout hash collision, the newer layout takes the slot
+        mPoses.erase(found);
+    }
+    driver.mFirst->ScaleAdd(bones, weight);
+    Pose &pose = mPoses[key];
+    for (int i = 0; i < bones.mBones.size(); i++) {
+        pose.mNames.push_back(bones.mBones[i].name.Str());
+        pose.mWeights.push_back(bones.mBones[i].weight);
+    }
+    pose.mData.assign(bones.Start(), bones.Start() + bones.TotalSize());
+    for (CharClipDriver *it = driver.mFirst; it != nullptr; it = it->Next()) {
+        pose.mClipWeights.push_back(it->mWeight);
+    }
+#ifdef MILO_DEBUG
+    mMisses++;
+    mMissMs += timer.SplitMs();
+#endif
+}
+
+#ifdef MILO_DEBUG
+void CharPoseCache::ResetStats() {
+    mHits = 0;
+    mMisses = 0;
+    mHitMs = 0;
+    mMissMs = 0;
+}
+
+float CharPoseCache::SavedMs() const {
+    if (mMisses == 0)
+        return 0;
+    return mHits * mMissMs / mMisses - mHitMs;
+}
+
+// (char_pose_cache beat_step) - sets how close in beats two drivers' clips must
+// be to share a pose, 0 to stop sharing
+static DataNode OnCharPoseCache(DataArray *a) {
+    TheCharPoseCache.mBeatStep = a->Float(1);
+    TheCharPoseCache.Clear();
+    TheCharPoseCache.ResetStats();
+    return 0;
+}
+
+// (char_pose_cache_stats label) - prints and resets the pose cache's hit rate
+// and the time it saved since the last call
+static DataNode OnCharPoseCacheStats(DataArray *a) {
+    CharPoseCache &cache = TheCharPoseCache;
+    int lookups = cache.mHits + cache.mMisses;
+    float saved = cache.SavedMs();
+    MILO_LOG(
+        "char_pose_cache %s: %d lookups, %.1f%% hits, %.2f ms evaluating, %.2f ms saved\n",
+        a->Size() > 1 ? a->Str(1) : "",
+        lookups,
+        lookups ? cache.mHits * 100.0f / lookups : 0.0f,
+        cache.mMissMs,
+        saved
+    );
+    cache.ResetStats();
+    return saved;
+}
+
+// (bench_char_pose_cache driver max_crowd) - evaluates the driver's pose for
+// crowds of 1, 2, 4 ... max_crowd identical characters, without and then with
+// the pose cache, and reports the hit rate and time saved for each size
+static DataNode OnBenchCharPoseCache(DataArray *a) {
+    CharDriver *driver = a->Obj<CharDriver>(1);
+    int maxCrowd = a->Size() > 2 ? a->Int(2) : 64;
+    if (!driver->mFirst || !driver->mInternalBones) {
+        MILO_WARN("%s has no clips playing through internal bones", driver->Name());
+        return 0;
+    }
+    CharPoseCache &cache = TheCharPoseCache;
+    float oldStep = cache.mBeatStep;
+    if (cache.mBeatStep <= 0)
+        cache.mBeatStep = 1 / 30.0f;
+    CharBones &bones = *driver->mInternalBones;
+    float weight = driver->Weight();
+    for (int crowd = 1; crowd <= maxCrowd; crowd *= 2) {
+        Timer timer;
+        timer.Restart();
+        for (int i = 0; i < crowd; i++) {
+            bones.Enter();
+            driver->mFirst->ScaleAdd(bones, weight);
+        }
+        float plainMs = timer.SplitMs();
+        cache.Clear();
+        cache.ResetStats();
+        for (int i = 0; i < crowd; i++) {
+            bones.Enter();
+            cache.ScaleAdd(*driver, bones, weight);
+        }
+        float cachedMs = timer.SplitMs() - plainMs;
+        MILO_LOG(
+            "bench_char_pose_cache: %d chars, %.1f%% hits, %.3f ms uncached, %.3f ms cached, %.3f ms saved\n",
+            crowd,
+            cache.mHits * 100.0f / crowd,
+            plainMs,
+            cachedMs,
+            plainMs - cachedMs
+        );
+    }
+    cache.Clear();
+    cache.ResetStats();
+    cache.mBeatStep = oldStep;
+    return 0;
+}
+#endif
+
+void CharDriver::Init() {
+    REGISTER_OBJ_FACTORY(CharDriver)
+    DataArray *cfg = SystemConfig("objects")->FindArray("CharDriver", false);
+    if (cfg)
+        cfg->FindData("pose_cache_beat_step", TheCharPoseCache.mBeatStep, false);
+#ifdef MILO_DEBUG
+    DataRegisterFunc("char_pose_cache", OnCharPoseCache);
+    DataRegisterFunc("char_pose_cache_stats", OnCharPoseCacheStats);
+    DataRegisterFunc("bench_char_pose_cache", OnBenchCharPoseCache);
+#endif
+}
+
 void CharDriver::Highlight() {
 #ifdef MILO_DEBUG
     if (gCharHighlightY == -1.0f)
@@ -309,7 +515,7 @@ void CharDriver::Poll() {
             if (mApply == kApplyBlend || mApply == kApplyBlendWeights) {
                 if (mInternalBones) {
                     mInternalBones->Enter();
-                    mFirst->ScaleAdd(*mInternalBones, f14);
+                    TheCharPoseCache.ScaleAdd(*this, *mInternalBones, f14);
                     mInternalBones->Blend(*mBones);
                 } else {
                     mFirst->GetClip()->ScaleDown(*mBones, f13);
@@ -5,6 +5,9 @@
 #include "char/CharPollable.h"
 #include "char/CharBones.h"
 #include "char/CharClipDriver.h"
+#include "math/Utl.h"
+#include <map>
+#include <vector>
 
 // forward decs
 class CharClip;
@@ -79,7 +82,7 @@ public:
     NEW_OVERLOAD;
     DELETE_OVERLOAD;
     NEW_OBJ(CharDriver)
-    static void Init() { REGISTER_OBJ_FACTORY(CharDriver) }
+    static void Init();
 
     /** "The CharBones object to add or blend into." */
     ObjPtr<CharBonesObject> mBones; // 0x28
@@ -110,3 +113,79 @@ public:
     bool mPlayMultipleClips; // 0x88
     bool unk89; // 0x89
 };
+
+/**
+ * @brief Poses shared between drivers blending the same clips the same way.
+ *
+ * Background characters often play the same clips at the same or nearby
+ * beats. A driver blending through internal bones looks its clip stack up
+ * here first, with beats quantized to mBeatStep, and copies the pose of any
+ * driver that already evaluated it this frame. Off while mBeatStep is 0,
+ * which the CharDriver config's pose_cache_beat_step can change.
+ */
+class CharPoseCache {
+public:
+    /** Clip drivers past this many in a stack skip the cache. */
+    static const int kMaxKeyClips = 4;
+
+    /** What a pose depends on, with beats and weights quantized. */
+    struct Key {
+        bool operator<(const Key &) const;
+
+        ObjectDir *mClips;
+        const char *mClipType;
+        /** Hash of the bones' compression, type counts and names. */
+        unsigned int mLayout;
+        int mWeight;
+        int mNumClips;
+        CharClip *mClip[kMaxKeyClips];
+        int mBeat[kMaxKeyClips];
+        int mDBeat[kMaxKeyClips];
+        int mBlendFrac[kMaxKeyClips];
+        /** mPlayMultipleClips of the driver, then of each clip driver. */
+        int mMultiple;
+    };
+
+    struct Pose {
+        /** The bone names the pose was made for, to rule out layout collisions. */
+        std::vector<const char *> mNames;
+        std::vector<char> mData;
+        std::vector<float> mWeights;
+        /** mWeight of each clip driver, which evaluating sets as a side effect. */
+        std::vector<float> mClipWeights;
+    };
+
+    CharPoseCache()
+        : mBeatStep(0), mFrame(kHugeFloat)
+#ifdef MILO_DEBUG
+          ,
+          mHits(0), mMisses(0), mHitMs(0), mMissMs(0)
+#endif
+    {
+    }
+
+    /** mFirst->ScaleAdd(bones, weight), through the cache when it is on. */
+    void ScaleAdd(CharDriver &, CharBones &bones, float weight);
+    void Clear() { mPoses.clear(); }
+
+    /** Beats closer than this share a pose; 0 turns the cache off. */
+    float mBeatStep;
+    float mFrame;
+    std::map<Key, Pose> mPoses;
+#ifdef MILO_DEBUG
+    void ResetStats();
+    /** Estimated ms saved by hits: what they would have cost, less the copies. */
+    float SavedMs() const;
+
+    int mHits;
+    int mMisses;
+    float mHitMs;
+    float mMissMs;
+#endif
+
+private:
+    /** Fill key for the driver's stack, false if it can't be keyed. */
+    bool MakeKey(const CharDriver &, const CharBones &, float weight, Key &key) const;
+};
+
+extern CharPoseCache TheCharPoseCache;
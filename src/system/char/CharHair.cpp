@@ -15,10 +15,14 @@
 #include "world/Dir.h"
 #include <cmath>
 #include "utl/Symbols.h"
+#include "obj/DataFunc.h"
+#include <vector>
 
 INIT_REVS(CharHair)
 CharHair *gHair;
 CharHair::Strand *gStrand;
+// skip sphere and cigar collides a point can't reach, off only to check it
+bool gHairBroadPhase = true;
 
 #pragma push
 #pragma dont_inline on
@@ -291,9 +295,16 @@ void CharHair::SimulateInternal(float f) {
                          it != thisPoint.collides.end();
                          ++it) {
                         CharCollide *thisCollide = *it;
+                        CharCollide::Shape shape = thisCollide->GetShape();
+                        if ((shape == CharCollide::kSphere
+                             || shape == CharCollide::kCigar)
+                            && gHairBroadPhase
+                            && !thisCollide->MayTouch(thisPoint.pos, maxRad)) {
+                            continue;
+                        }
                         Vector3 v164;
                         float collideRad = thisCollide->GetRadius(thisPoint.pos, v164);
-                        switch (thisCollide->GetShape()) {
+                        switch (shape) {
                         case CharCollide::kPlane: // 0
                             if (maxRad > collideRad) {
                                 ScaleAddEq(
@@ -425,6 +436,89 @@ void CharHair::SimulateZeroTime() {
     }
 }
 
+#ifdef MILO_DEBUG
+namespace {
+    // every point's simulated state, to replay the same frames
+    void SaveHairState(CharHair &hair, std::vector<Vector3> &state) {
+        state.clear();
+        for (int i = 0; i < hair.mStrands.size(); i++) {
+            ObjVector<CharHair::Point> &points = hair.mStrands[i].Points();
+            for (int j = 0; j < points.size(); j++) {
+                state.push_back(points[j].pos);
+                state.push_back(points[j].force);
+                state.push_back(points[j].lastFriction);
+                state.push_back(points[j].lastZ);
+            }
+        }
+    }
+
+    void RestoreHairState(CharHair &hair, const std::vector<Vector3> &state) {
+        const Vector3 *v = state.empty() ? 0 : &state[0];
+        for (int i = 0; i < hair.mStrands.size(); i++) {
+            ObjVector<CharHair::Point> &points = hair.mStrands[i].Points();
+            for (int j = 0; j < points.size(); j++) {
+                points[j].pos = *v++;
+                points[j].force = *v++;
+                points[j].lastFriction = *v++;
+                points[j].lastZ = *v++;
+            }
+        }
+    }
+}
+
+// (test_char_hair hair frames) - simulates frames of hair from its current
+// state with and without the collision broad phase, returns the largest
+// difference in point state between the two trajectories
+static DataNode OnTestCharHair(DataArray *a) {
+    CharHair *hair = a->Obj<CharHair>(1);
+    int frames = a->Size() > 2 ? a->Int(2) : 300;
+    float fps = hair->GetFPS();
+    std::vector<Vector3> start;
+    std::vector<Vector3> state;
+    std::vector<Vector3> trajectory;
+    SaveHairState(*hair, start);
+    Timer timers[2];
+    float maxErr = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        gHairBroadPhase = pass == 1;
+        RestoreHairState(*hair, start);
+        for (int f = 0; f < frames; f++) {
+            timers[pass].Start();
+            hair->SimulateLoops(1, fps);
+            timers[pass].Stop();
+            SaveHairState(*hair, state);
+            if (pass == 0) {
+                trajectory.insert(trajectory.end(), state.begin(), state.end());
+                continue;
+            }
+            const Vector3 *ref = &trajectory[f * state.size()];
+            for (int i = 0; i < state.size(); i++) {
+                MaxEq(maxErr, Distance(state[i], ref[i]));
+            }
+        }
+    }
+    gHairBroadPhase = true;
+    RestoreHairState(*hair, start);
+    MILO_LOG(
+        "test_char_hair: %s %d frames, %d floats of state: %.3f ms without broad phase, %.3f ms with, max difference %g\n",
+        hair->Name(),
+        frames,
+        start.size() * 3,
+        timers[0].Ms(),
+        timers[1].Ms(),
+        maxErr
+    );
+    return maxErr;
+}
+#endif
+
+void CharHair::Init() {
+    REGISTER_OBJ_FACTORY(CharHair)
+#ifdef MILO_DEBUG
+    DataRegisterFunc("test_char_hair", OnTestCharHair);
+#endif
+}
+
 void CharHair::PollDeps(
     std::list<Hmx::Object *> &changedBy, std::list<Hmx::Object *> &change
 ) {
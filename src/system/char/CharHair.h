@@ -106,7 +106,7 @@ public:
     DELETE_OVERLOAD;
     DECLARE_REVS;
     NEW_OBJ(CharHair)
-    static void Init() { REGISTER_OBJ_FACTORY(CharHair) }
+    static void Init();
 
     /** "stiffness of each strand". Ranges from 0 to 1. */
     float mStiffness; // 0x10
@@ -1,9 +1,14 @@
 #include "char/CharIKHand.h"
+#include "char/CharIKFingers.h"
+#include "char/CharIKFoot.h"
+#include "char/CharIKHead.h"
+#include "char/CharIKRod.h"
 #include "decomp.h"
 #include "math/Color.h"
 #include "math/Rot.h"
 #include "math/Vec.h"
 #include "obj/ObjMacros.h"
+#include "os/Timer.h"
 #include "rndobj/Rnd.h"
 #include "rndobj/Trans.h"
 #include "rndobj/Utl.h"
@@ -11,6 +16,33 @@
 
 INIT_REVS(CharIKHand)
 
+namespace {
+    // how strongly a target at pos pulls the hand
+    float TargetPull(const Vector3 &pos, float extent) {
+        Vector3 vec(pos);
+        if (extent <= 0.0f) {
+            return 144.0f / Max(0.001f, LengthSquared(vec));
+        } else if (extent < -vec.z) {
+            return 0.001f;
+        } else {
+            vec.z = 0.0f;
+            return 144.0f / Max(0.001f, LengthSquared(vec));
+        }
+    }
+
+    void AddTarget(
+        const Transform &xfm, float weight, bool orient, Vector3 &vec, Hmx::Quat &quat
+    ) {
+        ScaleAddEq(vec, xfm.v, weight);
+        if (orient) {
+            Hmx::Matrix3 m100;
+            Normalize(xfm.m, m100);
+            Hmx::Quat q268(m100);
+            ScaleAddEq(quat, q268, weight);
+        }
+    }
+}
+
 CharIKHand::CharIKHand()
     : mHand(this), mFinger(this), mTargets(this), mOrientation(1), mStretch(1),
       mScalable(0), mMoveElbow(1), mElbowSwing(0.0f), mAlwaysIKElbow(0), mAAPlusBB(0.0f),
@@ -40,47 +72,45 @@ void CharIKHand::Poll() {
             }
         }
     } else {
+        // gather each target's transform and pull once, then blend them; hands
+        // with more targets than fit find the pulls again while blending
+        const Transform *xfms[kMaxTargets];
+        float pulls[kMaxTargets];
+        bool gather = mTargets.size() <= kMaxTargets;
+        int numTargets = 0;
         float sumfloat = 0.0f;
-        float *locfloats;
-        float *startlocfloats = locfloats;
         for (std::vector<IKTarget>::iterator it = mTargets.begin(); it != mTargets.end();
              it++) {
             RndTransformable *itTrans = (*it).mTarget;
-            float itExtent = (*it).mExtent;
             if (itTrans) {
-                Vector3 vec(itTrans->WorldXfm().v);
-                if (itExtent <= 0.0f) {
-                    *locfloats = 144.0f / Max(0.001f, LengthSquared(vec));
-                } else if (itExtent < -vec.z) {
-                    *locfloats = 0.001f;
-                } else {
-                    vec.z = 0.0f;
-                    *locfloats = 144.0f / Max(0.001f, LengthSquared(vec));
+                const Transform &worldtf = itTrans->WorldXfm();
+                float pull = TargetPull(worldtf.v, (*it).mExtent);
+                if (gather) {
+                    xfms[numTargets] = &worldtf;
+                    pulls[numTargets++] = pull;
                 }
-
-                sumfloat += *locfloats++;
+                sumfloat += pull;
             }
         }
         if (sumfloat < 1.0f) {
             charWeight = charWeight - (charWeight * (1.0f - sumfloat));
         }
 
-        locfloats = startlocfloats;
-        for (std::vector<IKTarget>::iterator it = mTargets.begin(); it != mTargets.end();
-             it++) {
-            RndTransformable *itTrans = (*it).mTarget;
-            if (itTrans) {
-                float curFloat = *locfloats;
-                const Transform &worldtf = itTrans->WorldXfm();
-                ScaleAddEq(vec, worldtf.v, curFloat / sumfloat);
-                if (mOrientation) {
-                    Hmx::Matrix3 m100;
-                    Normalize(worldtf.m, m100);
-                    Hmx::Quat q268(m100);
-                    ScaleAddEq(quat, q268, curFloat / sumfloat);
+        if (gather) {
+            for (int i = 0; i < numTargets; i++) {
+                AddTarget(*xfms[i], pulls[i] / sumfloat, mOrientation, vec, quat);
+            }
+        } else {
+            for (std::vector<IKTarget>::iterator it = mTargets.begin();
+                 it != mTargets.end();
+                 it++) {
+                RndTransformable *itTrans = (*it).mTarget;
+                if (itTrans) {
+                    const Transform &worldtf = itTrans->WorldXfm();
+                    float pull = TargetPull(worldtf.v, (*it).mExtent);
+                    AddTarget(worldtf, pull / sumfloat, mOrientation, vec, quat);
                 }
             }
-            locfloats++;
         }
         if (mOrientation)
             Normalize(quat, quat);
@@ -411,6 +441,80 @@ void CharIKHand::Highlight() {
 #endif
 }
 
+#ifdef MILO_DEBUG
+namespace {
+    template <class T>
+    void GatherIK(ObjectDir *dir, std::vector<T *> &iks) {
+        for (ObjDirItr<T> it(dir, true); it != nullptr; ++it) {
+            iks.push_back(it);
+        }
+    }
+
+    // polls the IKs of one kind frames times, all of them each frame
+    template <class T>
+    void BenchIK(const std::vector<T *> &iks, int frames, const char *kind) {
+        if (iks.empty())
+            return;
+        Timer timer;
+        timer.Restart();
+        for (int i = 0; i < frames; i++) {
+            for (int j = 0; j < iks.size(); j++) {
+                iks[j]->Poll();
+            }
+        }
+        float ms = timer.SplitMs();
+        MILO_LOG(
+            "bench_char_ik: %d %s, %.3f ms/frame, %.2f us each\n",
+            iks.size(),
+            kind,
+            ms / frames,
+            ms * 1000.0f / (frames * iks.size())
+        );
+    }
+
+    template <class T>
+    void BenchIK(ObjectDir *dir, int frames, const char *kind) {
+        std::vector<T *> iks;
+        GatherIK(dir, iks);
+        BenchIK(iks, frames, kind);
+    }
+}
+
+// (bench_char_ik dir frames) - times the hand, finger, foot, head and rod IK of
+// every character under dir, without drawing anything; leaves the bones posed
+// by the last solve
+static DataNode OnBenchCharIK(DataArray *a) {
+    ObjectDir *dir = a->Obj<ObjectDir>(1);
+    int frames = a->Size() > 2 ? a->Int(2) : 100;
+    std::vector<CharIKHand *> hands;
+    std::vector<CharIKFoot *> feet;
+    GatherIK(dir, hands);
+    // feet are hands too, time them on their own
+    std::vector<CharIKHand *> handsOnly;
+    for (int i = 0; i < hands.size(); i++) {
+        CharIKFoot *foot = dynamic_cast<CharIKFoot *>(hands[i]);
+        if (foot)
+            feet.push_back(foot);
+        else
+            handsOnly.push_back(hands[i]);
+    }
+    hands.swap(handsOnly);
+    BenchIK(hands, frames, "hands");
+    BenchIK(feet, frames, "feet");
+    BenchIK<CharIKFingers>(dir, frames, "fingers");
+    BenchIK<CharIKHead>(dir, frames, "heads");
+    BenchIK<CharIKRod>(dir, frames, "rods");
+    return 0;
+}
+#endif
+
+void CharIKHand::Init() {
+    REGISTER_OBJ_FACTORY(CharIKHand)
+#ifdef MILO_DEBUG
+    DataRegisterFunc("bench_char_ik", OnBenchCharIK);
+#endif
+}
+
 SAVE_OBJ(CharIKHand, 0x2A8)
 
 BEGIN_LOADS(CharIKHand)
@@ -23,6 +23,9 @@ public:
         float mExtent; // 0xc
     };
 
+    /** Most targets Poll gathers up front; past this it finds each pull twice. */
+    static const int kMaxTargets = 8;
+
     CharIKHand();
     virtual ~CharIKHand();
     virtual void Highlight();
@@ -46,7 +49,7 @@ public:
     DELETE_OVERLOAD;
     DECLARE_REVS;
     NEW_OBJ(CharIKHand)
-    static void Init() { REGISTER_OBJ_FACTORY(CharIKHand) }
+    static void Init();
 
     /** "The hand to be moved, must be child of elbow" */
     ObjPtr<RndTransformable> mHand; // 0x28
@@ -5,6 +5,7 @@
 #include "obj/ObjMacros.h"
 #include "obj/Object.h"
 #include "os/Debug.h"
+#include "os/Timer.h"
 #include "rndobj/PropAnim.h"
 #include "rndobj/PropKeys.h"
 #include "utl/Symbols.h"
@@ -27,10 +28,27 @@ void CharLipSync::Generator::Init(CharLipSync *sync) {
     mLipSync->mFrames = 0;
 }
 
-void CharLipSync::Generator::AddWeight(int i, float f) { Clamp<float>(0, 255, f); }
+void CharLipSync::Generator::AddWeight(int i, float f) {
+    Weight &weight = mWeights[i];
+    unsigned char w = Clamp<float>(0, 255, f) + 0.5f;
+    if (weight.unk1) {
+        MILO_WARN("viseme %d weighted twice in frame %d", i, mLipSync->mFrames);
+        return;
+    }
+    weight.unk1 = true;
+    // only changes are written, so a held viseme costs nothing
+    if (w != weight.unk0) {
+        mLipSync->mData.push_back(i);
+        mLipSync->mData.push_back(w);
+        weight.unk0 = w;
+    }
+}
 
 void CharLipSync::Generator::NextFrame() {
-    int count = mLipSync->mData.size() - mLastCount;
+    for (int i = 0; i < mWeights.size(); i++) {
+        mWeights[i].unk1 = false;
+    }
+    int count = (mLipSync->mData.size() - mLastCount) / 2;
     MILO_ASSERT(count >= 0 && count < 256, 0x40);
     mLipSync->mData[mLastCount] = count;
     mLastCount = mLipSync->mData.size();
@@ -52,7 +70,7 @@ void CharLipSync::Generator::Finish() {
         for (int j = 0; j < count; j++) {
             int viseme = mLipSync->mData[idx++];
             MILO_ASSERT(viseme < mLipSync->mVisemes.size(), 0x5B);
-            if (mLipSync->mData[idx] != 0) {
+            if (mLipSync->mData[idx++] != 0) {
                 bools[viseme] = true;
             }
         }
@@ -69,14 +87,32 @@ void CharLipSync::Generator::Finish() {
 
 void CharLipSync::Generator::RemoveViseme(int visemeIdx) {
     mLipSync->mVisemes.erase(mLipSync->mVisemes.begin() + visemeIdx);
+    if (visemeIdx < mWeights.size())
+        mWeights.erase(mWeights.begin() + visemeIdx);
 
+    // drop its pairs and renumber the visemes after it, compacting in place
+    std::vector<unsigned char VECTOR_SIZE_LARGE> &data = mLipSync->mData;
     int idx = 0;
+    int cur = 0;
     for (int i = 0; i < mLipSync->mFrames; i++) {
-        int count = mLipSync->mData[idx++];
+        int count = data[idx++];
+        int countIdx = cur++;
+        int kept = 0;
         for (int j = 0; j < count; j++) {
-            MILO_WARN("data[cur] < mLipSync->mVisemes.size()");
+            int viseme = data[idx++];
+            unsigned char weight = data[idx++];
+            if (viseme == visemeIdx)
+                continue;
+            data[cur] = viseme > visemeIdx ? viseme - 1 : viseme;
+            if (data[cur] >= mLipSync->mVisemes.size())
+                MILO_FAIL("data[cur] < mLipSync->mVisemes.size()");
+            data[cur + 1] = weight;
+            cur += 2;
+            kept++;
         }
+        data[countIdx] = kept;
     }
+    data.resize(cur);
 }
 
 CharLipSync::PlayBack::PlayBack()
@@ -114,6 +150,7 @@ void CharLipSync::PlayBack::Set(CharLipSync *lipsync, ObjectDir *dir) {
 
 void CharLipSync::PlayBack::Reset() {
     mIndex = 0;
+    mOldIndex = 0;
     mFrame = -1;
     for (int i = 0; i < mWeights.size(); i++) {
         Weight &weight = mWeights[i];
@@ -123,7 +160,46 @@ void CharLipSync::PlayBack::Reset() {
     }
 }
 
-void CharLipSync::PlayBack::Poll(float f) {}
+void CharLipSync::PlayBack::Poll(float f) {
+    float frame = f * 30.0f;
+    if (mPropAnim) {
+        mPropAnim->SetFrame(frame, 1);
+        // one weight per key track, the viseme's weight at this frame
+        std::vector<PropKeys *> &keys = mPropAnim->mPropKeys;
+        for (int i = 0; i < mWeights.size(); i++) {
+            Weight &weight = mWeights[i];
+            weight.unk14 = 0;
+            if (i < keys.size() && keys[i]->mKeysType == PropKeys::kFloat
+                && !keys[i]->AsFloatKeys().empty()) {
+                keys[i]->FloatAt(frame, weight.unk14);
+            }
+        }
+        return;
+    }
+    if (!mLipSync || mLipSync->mFrames == 0)
+        return;
+    int next = Clamp(0, mLipSync->mFrames - 1, (int)std::ceil(frame));
+    if (next < mFrame)
+        Reset();
+    const std::vector<unsigned char VECTOR_SIZE_LARGE> &data = mLipSync->mData;
+    while (mFrame < next) {
+        for (int i = 0; i < mWeights.size(); i++) {
+            mWeights[i].unkc = mWeights[i].unk10;
+        }
+        mOldIndex = mIndex;
+        int count = data[mIndex++];
+        for (int j = 0; j < count; j++) {
+            int viseme = data[mIndex++];
+            mWeights[viseme].unk10 = data[mIndex++] / 255.0f;
+        }
+        mFrame++;
+    }
+    float t = Clamp(0.0f, 1.0f, frame - (mFrame - 1));
+    for (int i = 0; i < mWeights.size(); i++) {
+        Weight &weight = mWeights[i];
+        weight.unk14 = Interp(weight.unkc, weight.unk10, t);
+    }
+}
 
 CharLipSync::CharLipSync() : mPropAnim(this), mFrames(0) {}
 
@@ -173,6 +249,92 @@ void CharLipSync::Parse(DataArray *arr) {
     gen.Finish();
 }
 
+void CharLipSync::Decode(std::vector<unsigned char> &frames) const {
+    int numVisemes = mVisemes.size();
+    frames.resize(mFrames * numVisemes);
+    std::vector<unsigned char> cur(numVisemes, 0);
+    int idx = 0;
+    for (int i = 0; i < mFrames; i++) {
+        int count = mData[idx++];
+        for (int j = 0; j < count; j++) {
+            int viseme = mData[idx++];
+            cur[viseme] = mData[idx++];
+        }
+        std::copy(cur.begin(), cur.end(), frames.begin() + i * numVisemes);
+    }
+}
+
+void CharLipSync::Recompress() {
+    std::vector<unsigned char> frames;
+    Decode(frames);
+    int numVisemes = mVisemes.size();
+    int numFrames = mFrames;
+    Generator gen;
+    gen.Init(this);
+    for (int i = 0; i < numFrames; i++) {
+        for (int j = 0; j < numVisemes; j++) {
+            gen.AddWeight(j, frames[i * numVisemes + j]);
+        }
+        gen.NextFrame();
+    }
+    gen.Finish();
+}
+
+#ifdef MILO_DEBUG
+// (recompress_lipsync dir) - encodes every lipsync in dir again, keeping only
+// the viseme changes of each frame, and reports the bytes saved and the cost
+// of decoding a frame during playback
+static DataNode OnRecompressLipSync(DataArray *a) {
+    ObjectDir *dir = a->Obj<ObjectDir>(1);
+    int oldBytes = 0;
+    int newBytes = 0;
+    int frames = 0;
+    Timer timer;
+    for (ObjDirItr<CharLipSync> it(dir, true); it != nullptr; ++it) {
+        if (it->GetPropAnim())
+            continue;
+        int old = it->mData.size();
+        it->Recompress();
+        CharLipSync::PlayBack player;
+        player.mLipSync = it;
+        player.mWeights.resize(it->mVisemes.size());
+        player.Reset();
+        timer.Start();
+        for (int i = 0; i < it->mFrames; i++) {
+            player.Poll(i / 30.0f);
+        }
+        timer.Stop();
+        MILO_LOG(
+            "%s: %d frames, %d visemes, %d -> %d bytes\n",
+            it->Name(),
+            it->mFrames,
+            it->mVisemes.size(),
+            old,
+            it->mData.size()
+        );
+        oldBytes += old;
+        newBytes += it->mData.size();
+        frames += it->mFrames;
+    }
+    MILO_LOG(
+        "recompress_lipsync: %d -> %d bytes, %d frames decoded in %.2f ms (%.3f us/frame)\n",
+        oldBytes,
+        newBytes,
+        frames,
+        timer.Ms(),
+        frames ? timer.Ms() * 1000.0f / frames : 0.0f
+    );
+    return oldBytes - newBytes;
+}
+#endif
+
+void CharLipSync::Init() {
+    REGISTER_OBJ_FACTORY(CharLipSync)
+#ifdef MILO_DEBUG
+    DataRegisterFunc("recompress_lipsync", OnRecompressLipSync);
+#endif
+}
+
 BEGIN_COPYS(CharLipSync)
     COPY_SUPERCLASS(Hmx::Object)
     CREATE_COPY(CharLipSync)
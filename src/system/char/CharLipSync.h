@@ -11,10 +11,17 @@
  * visemes.  Sampled at 30hz" */
 class CharLipSync : public Hmx::Object {
 public:
+    /**
+     * Encodes frames into mData. Each frame is a count followed by that many
+     * (viseme, weight) byte pairs, one for each viseme whose weight changed
+     * since the frame before; weights are 0-255.
+     */
     class Generator {
     public:
         struct Weight {
+            /** Weight last written for the viseme. */
             unsigned char unk0;
+            /** Whether AddWeight already wrote it this frame. */
             unsigned char unk1;
         };
 
@@ -30,13 +37,21 @@ public:
         std::vector<Weight> mWeights; // 0x8
     };
 
+    /**
+     * Decodes mData as it plays. Moving forward only reads the frames passed
+     * over, so a poll costs the visemes that changed rather than the song so
+     * far; only seeking back restarts from the first frame.
+     */
     class PlayBack {
     public:
         struct Weight {
             Weight() : unk0(0) {}
             ObjPtr<CharClip> unk0;
+            /** Weight at frame mFrame - 1. */
             float unkc;
+            /** Weight at frame mFrame. */
             float unk10;
+            /** Weight at the time last polled. */
             float unk14;
         };
 
@@ -49,8 +64,11 @@ public:
         CharLipSync *mLipSync; // 0x8
         RndPropAnim *mPropAnim; // 0xc
         ObjectDir *mClips; // 0x10
+        /** Offset in mData of the next frame to decode. */
         int mIndex; // 0x14
+        /** Offset in mData of frame mFrame. */
         int mOldIndex; // 0x18
+        /** Last frame decoded, -1 before the first. */
         int mFrame; // 0x1c
     };
 
@@ -65,6 +83,10 @@ public:
     virtual void Load(BinStream &);
 
     void Parse(DataArray *);
+    /** Decode and encode mData again, dropping unchanged and unused visemes. */
+    void Recompress();
+    /** Weights of every viseme at every frame, frame by frame, 0-255. */
+    void Decode(std::vector<unsigned char> &) const;
     RndPropAnim *GetPropAnim() const { return mPropAnim; }
     float Duration() { return (float)(mFrames - 1) / 30.0f; }
 
@@ -75,7 +97,7 @@ public:
     NEW_OVERLOAD;
     DELETE_OVERLOAD;
     NEW_OBJ(CharLipSync)
-    static void Init() { REGISTER_OBJ_FACTORY(CharLipSync) }
+    static void Init();
 
     /** "PropAnim to control this lipsync" */
     ObjPtr<RndPropAnim> mPropAnim; // 0x1c
@@ -2,6 +2,7 @@
 #include "rndobj/Poll.h"
 #include <list>
 #include <map>
+#include <vector>
 
 /** "Workhorse unit of the Character system, most Character things inherit from this." */
 class CharPollable : public RndPollable {
@@ -18,6 +19,8 @@ public:
         std::list<Dep *> changedBy; // 0x4
         RndPollable *poll; // 0xc
         int searchID; // 0x10
+        /** 1-based index into the polls being sorted, 0 for other objects. */
+        int pollIndex; // 0x14
     };
 
     struct AlphaSort {
@@ -31,6 +34,8 @@ public:
     void Sort(std::vector<RndPollable *> &);
     bool ChangedBy(Dep *, Dep *);
     bool ChangedByRecurse(Dep *);
+    /** Set the bit of every poll that d is changed by, directly or not. */
+    void MarkChangedBy(Dep *d, std::vector<unsigned int> &bits, int row);
     void AddDeps(Dep *, const std::list<Hmx::Object *> &, std::list<Dep *> &, bool);
 
     static int sSearchID;
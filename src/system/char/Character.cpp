@@ -111,12 +111,29 @@ void CharPollableSorter::Sort(std::vector<RndPollable *> &polls) {
             }
         }
 
+        // Walk the graph once per poll to find everything it is changed by, so
+        // the insertion below is bit tests rather than a graph search per pair.
+        int numPolls = deps.size();
+        int words = (numPolls + 31) >> 5;
+        std::vector<unsigned int> changedBy(numPolls * words, 0);
+        for (int i = 0; i < numPolls; i++) {
+            deps[i]->pollIndex = i + 1;
+        }
+        for (int i = 0; i < numPolls; i++) {
+            sSearchID++;
+            deps[i]->searchID = sSearchID;
+            MarkChangedBy(deps[i], changedBy, i * words);
+        }
+
         std::list<Dep *> otherDepList;
         for (int i = 0; i < deps.size(); i++) {
             Dep *curDep = deps[i];
+            int bit = curDep->pollIndex - 1;
             std::list<Dep *>::iterator it = otherDepList.begin();
             for (; it != otherDepList.end(); ++it) {
-                if (ChangedBy(curDep, *it))
+                // same as ChangedBy(curDep, *it)
+                int row = ((*it)->pollIndex - 1) * words;
+                if (changedBy[row + (bit >> 5)] & 1 << (bit & 31))
                     break;
             }
             otherDepList.insert(it, curDep);
@@ -158,6 +175,21 @@ bool CharPollableSorter::ChangedByRecurse(Dep *d) {
     }
 }
 
+void CharPollableSorter::MarkChangedBy(Dep *d, std::vector<unsigned int> &bits, int row) {
+    for (std::list<Dep *>::iterator it = d->changedBy.begin(); it != d->changedBy.end();
+         ++it) {
+        Dep *cur = *it;
+        if (cur->searchID != sSearchID) {
+            cur->searchID = sSearchID;
+            if (cur->pollIndex) {
+                int bit = cur->pollIndex - 1;
+                bits[row + (bit >> 5)] |= 1 << (bit & 31);
+            }
+            MarkChangedBy(cur, bits, row);
+        }
+    }
+}
+
 // fn_8049DD04
 void CharPollableSorter::AddDeps(
     Dep *me, const std::list<Hmx::Object *> &odeps, std::list<Dep *> &toDo, bool changedBy
@@ -193,6 +225,7 @@ Character::Character()
       mDebugDrawInterestObjects(0)
 #endif
 {
+    mTransList.SetRoot(this);
 }
 
 Character::~Character() {
@@ -221,6 +254,8 @@ void Character::Poll() {
         if (LOADMGR_EDITMODE)
             mTest->Poll();
         RndDir::Poll();
+        if (RndTransList::sBatchUpdate)
+            mTransList.Update();
         mTeleported = false;
         mPollState = kCharPolled;
     }
@@ -372,11 +407,12 @@ void Character::CalcBoundingSphere() {
                 mBounding.GrowToContain(Sphere(it->WorldXfm().v, 0.1f));
             }
             RndMesh *mesh = dynamic_cast<RndMesh *>(&*it);
-            if (mesh && mesh->Showing()) {
-                for (int i = 0; i < mesh->Verts().size(); i++) {
-                    mBounding.GrowToContain(
-                        Sphere(mesh->SkinVertex(mesh->Verts(i), nullptr), 0.001f)
-                    );
+            if (mesh && mesh->Showing() && !mesh->Verts().empty()) {
+                int numVerts = mesh->Verts().size();
+                std::vector<Vector3> verts(numVerts);
+                mesh->SkinVerts(0, numVerts, &verts[0], nullptr, RndMesh::kSkinLinear);
+                for (int i = 0; i < numVerts; i++) {
+                    mBounding.GrowToContain(Sphere(verts[i], 0.001f));
                 }
             }
         }
@@ -170,7 +170,9 @@ public:
     Symbol mInterestToForce; // 0x1f8
     ObjPtr<RndEnviron> unk1fc; // 0x1fc
     Vector3 *unk208; // 0x208
+    /** Every trans under this one, for refreshing world xfms in one pass. */
+    RndTransList mTransList; // 0x20c
 #ifdef MILO_DEBUG
-    bool mDebugDrawInterestObjects; // 0x20c
+    bool mDebugDrawInterestObjects; // 0x220
 #endif
 };
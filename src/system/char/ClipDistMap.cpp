@@ -30,6 +30,53 @@ void FindWeights(
     }
 }
 
+namespace {
+    // weighted rms distance between the bones of two poses
+    float
+    PoseDist(const DistEntry &a, const DistEntry &b, const std::vector<float> &weights) {
+        int numBones = a.bones.size();
+        int numWeights = weights.size();
+        float sum = 0;
+        for (int k = 0, w = 0; k < numBones; k++) {
+            sum += DistanceSquared(a.bones[k], b.bones[k]) * weights[w];
+            if (++w == numWeights)
+                w = 0;
+        }
+        return std::sqrt(sum / (float)numBones);
+    }
+}
+
+void ClipPoseCache::Clear() {
+    mPoses.clear();
+    mResource = 0;
+    mNumPoses = 0;
+    mNumDists = 0;
+}
+
+void ClipPoseCache::SetResource(CharBoneDir *dir) {
+    if (dir != mResource) {
+        mPoses.clear();
+        mResource = dir;
+    }
+}
+
+const DistEntry &ClipPoseCache::Pose(
+    ClipDistMap &map,
+    CharBonesMeshes &meshes,
+    CharClip *clip,
+    float beat,
+    const std::vector<RndTransformable *> &transes
+) {
+    std::map<float, DistEntry> &poses = mPoses[clip];
+    std::map<float, DistEntry>::iterator it = poses.find(beat);
+    if (it == poses.end()) {
+        it = poses.insert(std::make_pair(beat, DistEntry())).first;
+        map.GenerateDistEntry(meshes, it->second, beat, clip, transes);
+        mNumPoses++;
+    }
+    return it->second;
+}
+
 ClipDistMap::ClipDistMap(
     CharClip *clip1, CharClip *clip2, float f1, float f2, int i, const DataArray *a
 )
@@ -41,7 +88,7 @@ DECOMP_FORCEACTIVE(ClipDistMap, "bone_facing.rotz")
 
 #pragma push
 #pragma dont_inline on
-void ClipDistMap::FindDists(float f1, DataArray *arr) {
+void ClipDistMap::FindDists(float f1, DataArray *arr, ClipPoseCache *cache) {
     CharBoneDir *rsrcA = mClipA->GetResource();
     CharUtlBoneSaver saver(rsrcA);
     CharBonesMeshes meshes;
@@ -74,8 +121,10 @@ void ClipDistMap::FindDists(float f1, DataArray *arr) {
     DataNode &dataVarDelta = DataVariable("delta");
     float varDelta = dataVarDelta.Float();
 
-    std::vector<DistEntry> distEntries;
-    distEntries.resize(mDists.Height());
+    ClipPoseCache localCache;
+    if (!cache)
+        cache = &localCache;
+    cache->SetResource(rsrcA);
     std::vector<float> floatVec;
     float interpA = Interp(mClipA->StartBeat(), mClipA->EndBeat(), 0.5f);
     float interpB = Interp(mClipB->StartBeat(), mClipB->EndBeat(), 0.5f);
@@ -83,7 +132,8 @@ void ClipDistMap::FindDists(float f1, DataArray *arr) {
 
     for (int i = 0; i < mDists.Width(); i++) {
         float beatA = BeatA(i);
-        DistEntry newDistEntry;
+        // rows whose pairs all get pruned are never posed
+        const DistEntry *newDistEntry = 0;
         for (int j = 0; j < mDists.Height(); j++) {
             mDists(i, j) = kHugeFloat;
             float beatB = BeatB(j);
@@ -129,24 +179,20 @@ void ClipDistMap::FindDists(float f1, DataArray *arr) {
                 //             goto LAB_8072e548;
                 //           }
                 //         }
-                DistEntry &curDistEntry = distEntries[j];
-                GenerateDistEntry(meshes, curDistEntry, BeatB(j), mClipB, transes);
-                GenerateDistEntry(meshes, newDistEntry, BeatA(i), mClipA, transes);
+                const DistEntry &curDistEntry =
+                    cache->Pose(*this, meshes, mClipB, beatB, transes);
+                if (!newDistEntry)
+                    newDistEntry = &cache->Pose(*this, meshes, mClipA, beatA, transes);
                 if (f1 > 0) {
                     float fvar1 = 0.33333334f;
-                    float fvar2 = newDistEntry.facing[0];
+                    float fvar2 = newDistEntry->facing[0];
                     // some more stuff happens here
                 }
                 if (floatVec.empty()) {
                     FindWeights(transes, floatVec, mWeightData);
                 }
-                float f314 = 0;
-                for (int k = 0; k < newDistEntry.bones.size(); k++) {
-                    float curFloat = floatVec[k % floatVec.size()];
-                    f314 += DistanceSquared(newDistEntry.bones[k], curDistEntry.bones[k])
-                        * curFloat;
-                }
-                f314 = std::sqrt(f314 / (float)newDistEntry.bones.size());
+                float f314 = PoseDist(*newDistEntry, curDistEntry, floatVec);
+                cache->mNumDists++;
                 MaxEq(mWorstErr, f314);
                 mDists(i, j) = f314;
             }
@@ -3,6 +3,7 @@
 #include "char/CharClip.h"
 #include "char/CharDriver.h"
 #include "rndobj/Trans.h"
+#include <map>
 #include <vector>
 
 class DistEntry {
@@ -15,6 +16,36 @@ public:
     float facing[4]; // 0xc
 };
 
+class CharBoneDir;
+class ClipDistMap;
+
+/**
+ * Poses of clips at sample beats, shared by the ClipDistMaps of a transition
+ * generation pass so each clip is posed once per beat rather than once per
+ * pair it's in. Whoever runs the pass clears it when the pass ends.
+ */
+class ClipPoseCache {
+public:
+    ClipPoseCache() : mResource(0), mNumPoses(0), mNumDists(0) {}
+    void Clear();
+    /** Poses are in the space of one resource, switching drops them all. */
+    void SetResource(CharBoneDir *);
+    /** The pose of clip at beat, generating it through map if needed. */
+    const DistEntry &Pose(
+        ClipDistMap &map,
+        CharBonesMeshes &meshes,
+        CharClip *clip,
+        float beat,
+        const std::vector<RndTransformable *> &transes
+    );
+
+    CharBoneDir *mResource; // 0x0
+    std::map<CharClip *, std::map<float, DistEntry> > mPoses; // 0x4
+    /** Poses generated, and distances found from them. */
+    int mNumPoses; // 0x1c
+    int mNumDists; // 0x20
+};
+
 class ClipDistMap {
 public:
     class Array2d {
@@ -40,7 +71,8 @@ public:
     };
 
     ClipDistMap(CharClip *, CharClip *, float, float, int, const DataArray *);
-    void FindDists(float, DataArray *);
+    /** Without a cache, poses are still shared across this map's rows. */
+    void FindDists(float, DataArray *, ClipPoseCache *cache = 0);
     void FindNodes(float, float, float);
     void SetNodes(Node *, Node *);
     void Draw(float, float, CharDriver *);
@@ -1,6 +1,9 @@
 #include "char/ClipGraphGen.h"
 #include "decomp.h"
+#include "obj/DataFunc.h"
+#include "obj/Dir.h"
 #include "os/Debug.h"
+#include "os/Timer.h"
 #include "utl/Symbols.h"
 
 ClipGraphGenerator::ClipGraphGenerator() : unk1c(0), mDmap(0), mClipA(0), mClipB(0) {}
@@ -32,6 +35,9 @@ ClipDistMap *ClipGraphGenerator::GeneratePair(
             mDmap = 0;
             a_clip = DataNode(c1);
             b_clip = DataNode(c2);
+            // a pass is every pair from one source clip
+            if (c1 != mClipA)
+                mPoseCache.Clear();
             mClipA = c1;
             mClipB = c2;
             transarr->ExecuteScript(1, this, 0, 1);
@@ -100,7 +106,51 @@ DataNode ClipGraphGenerator::OnGenerateTransitions(DataArray *da) {
 
     DataArray *boneweightarr = unk1c->FindArray("transition_bone_weights", false);
     mDmap = new ClipDistMap(mClipA, mClipB, beat_align, blend_width, 3, boneweightarr);
-    mDmap->FindDists(max_facing * DEG2RAD, restrictArr);
+    mDmap->FindDists(max_facing * DEG2RAD, restrictArr, &mPoseCache);
     mDmap->FindNodes(max_error, max_dist, end_dist);
     return 0;
-}
\ No newline at end of file
+}
+#ifdef MILO_DEBUG
+// (bench_clip_dists clip_dir max_pairs) - finds the distance maps of up to
+// max_pairs clip pairs in clip_dir, sharing poses across the pairs of each
+// source clip the way the generator does, and reports the time and poses
+static DataNode OnBenchClipDists(DataArray *a) {
+    ObjectDir *dir = a->Obj<ObjectDir>(1);
+    int maxPairs = a->Size() > 2 ? a->Int(2) : 1000;
+    std::vector<CharClip *> clips;
+    for (ObjDirItr<CharClip> it(dir, true); it != nullptr; ++it) {
+        clips.push_back(it);
+    }
+    ClipPoseCache cache;
+    Timer timer;
+    timer.Restart();
+    int pairs = 0;
+    int poses = 0;
+    int dists = 0;
+    for (int i = 0; i < clips.size() && pairs < maxPairs; i++) {
+        for (int j = 0; j < clips.size() && pairs < maxPairs; j++, pairs++) {
+            ClipDistMap dmap(clips[i], clips[j], 0, 1, 3, nullptr);
+            dmap.FindDists(0, nullptr, &cache);
+        }
+        poses += cache.mNumPoses;
+        dists += cache.mNumDists;
+        cache.Clear();
+    }
+    MILO_LOG(
+        "bench_clip_dists: %d pairs of %d clips: %.1f ms, %d poses for %d distances (%d without sharing)\n",
+        pairs,
+        clips.size(),
+        timer.SplitMs(),
+        poses,
+        dists,
+        dists * 2
+    );
+    return poses;
+}
+#endif
+
+void ClipGraphGenerator::Init() {
+#ifdef MILO_DEBUG
+    DataRegisterFunc("bench_clip_dists", OnBenchClipDists);
+#endif
+}
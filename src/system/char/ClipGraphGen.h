@@ -12,8 +12,12 @@ public:
     GeneratePair(CharClip *, CharClip *, ClipDistMap::Node *, ClipDistMap::Node *);
     DataNode OnGenerateTransitions(DataArray *);
 
+    static void Init();
+
     const DataArray *unk1c;
     ClipDistMap *mDmap; // 0x20
     CharClip *mClipA; // 0x24
     CharClip *mClipB; // 0x28
+    /** Poses shared by the pairs of one source clip, cleared when it changes. */
+    ClipPoseCache mPoseCache; // 0x2c
 };
@@ -9,6 +9,7 @@
 #include "obj/ObjMacros.h"
 #include "obj/Object.h"
 #include "obj/Utl.h"
+#include "math/Utl.h"
 #include "os/Debug.h"
 #include "rndobj/Group.h"
 #include "rndobj/Mat.h"
@@ -25,6 +26,32 @@ INIT_REVS(FileMerger)
 bool FileMerger::sDisableAll;
 FileMerger *FileMerger::sFmDeleting;
 
+#ifdef MILO_DEBUG
+namespace {
+    // swap latency of every FileMerger, since the last file_merger_stats
+    struct SwapStats {
+        SwapStats() { Clear(); }
+        void Clear() {
+            mSwaps = 0;
+            mSkipped = 0;
+            mLoadMs = 0;
+            mMaxLoadMs = 0;
+            mMergeMs = 0;
+            mMaxMergeMs = 0;
+        }
+
+        int mSwaps;
+        /** Reloads dropped because the selection came back to the merged file. */
+        int mSkipped;
+        float mLoadMs;
+        float mMaxLoadMs;
+        /** Merging blocks the frame it finishes in, loading doesn't. */
+        float mMergeMs;
+        float mMaxMergeMs;
+    } gSwapStats;
+}
+#endif
+
 #pragma push
 #pragma pool_data off
 void FileMerger::Merger::Clear() {
@@ -98,7 +125,10 @@ bool FileMerger::StartLoadInternal(bool b1, bool b2) {
     HandleType(msg);
     for (int i = 0; i < mMergers.size(); i++) {
         Merger &cur = mMergers[i];
-        if (NeedsLoading(cur)) {
+        if (!cur.unk29 && cur.mSelected == cur.mLoaded && IsPending(cur)) {
+            // browsed back to what is merged already, so there's nothing to load
+            CancelLoad(cur);
+        } else if (NeedsLoading(cur)) {
             AppendLoader(cur);
         }
     }
@@ -173,6 +203,35 @@ bool FileMerger::NeedsLoading(FileMerger::Merger &merger) {
     return merger.mLoaded != merger.mSelected || merger.unk29;
 }
 
+bool FileMerger::IsPending(FileMerger::Merger &merger) {
+    for (std::list<Merger *>::iterator it = mFilesPending.begin();
+         it != mFilesPending.end();
+         ++it) {
+        if (*it == &merger)
+            return true;
+    }
+    return false;
+}
+
+void FileMerger::CancelLoad(FileMerger::Merger &merger) {
+    for (std::list<Merger *>::iterator it = mFilesPending.begin();
+         it != mFilesPending.end();
+         ++it) {
+        if (*it == &merger) {
+            // failing the current loader pops it off mFilesPending
+            if (mCurLoader && it == mFilesPending.begin())
+                DeleteCurLoader();
+            else
+                mFilesPending.erase(it);
+            break;
+        }
+    }
+    merger.loading.SetRoot("");
+#ifdef MILO_DEBUG
+    gSwapStats.mSkipped++;
+#endif
+}
+
 void FileMerger::AppendLoader(FileMerger::Merger &merger) {
     merger.unk29 = false;
     for (std::list<Merger *>::iterator it = mFilesPending.begin();
@@ -228,6 +287,9 @@ next:
         pos = 2;
     FilePath &fp = mFilesPending.front()->loading;
     MemTempHeap tmp(mHeap);
+#ifdef MILO_DEBUG
+    mSwapTimer.Restart();
+#endif
     if (fp.empty()) {
         mCurLoader = new NullLoader(fp, (LoaderPos)pos, mOrganizer);
     } else {
@@ -355,6 +417,9 @@ FileMerger::Merger *FileMerger::NotifyFileLoaded(Loader *l, ObjectDir *dir) {
 }
 
 void FileMerger::FinishLoading(Loader *l) {
+#ifdef MILO_DEBUG
+    float loadMs = mSwapTimer.SplitMs();
+#endif
     DirLoader *d = dynamic_cast<DirLoader *>(l);
     ObjectDir *dDir = d ? d->GetDir() : nullptr;
     Merger *m = NotifyFileLoaded(l, dDir);
@@ -383,6 +448,14 @@ void FileMerger::FinishLoading(Loader *l) {
         } else
             delete d;
     }
+#ifdef MILO_DEBUG
+    float mergeMs = mSwapTimer.SplitMs() - loadMs;
+    gSwapStats.mSwaps++;
+    gSwapStats.mLoadMs += loadMs;
+    MaxEq(gSwapStats.mMaxLoadMs, loadMs);
+    gSwapStats.mMergeMs += mergeMs;
+    MaxEq(gSwapStats.mMaxMergeMs, mergeMs);
+#endif
     PostMerge(m, true);
 }
 
@@ -409,6 +482,67 @@ void FileMerger::PostMerge(FileMerger::Merger *merger, bool b) {
         LaunchNextLoader();
 }
 
+#ifdef MILO_DEBUG
+// (file_merger_stats) - prints and resets the swap latency of every FileMerger
+static DataNode OnFileMergerStats(DataArray *) {
+    SwapStats &stats = gSwapStats;
+    int swaps = Max(stats.mSwaps, 1);
+    MILO_LOG(
+        "file_merger_stats: %d swaps, %d reloads skipped, load %.1f ms avg %.1f max, merge %.2f ms avg %.2f max\n",
+        stats.mSwaps,
+        stats.mSkipped,
+        stats.mLoadMs / swaps,
+        stats.mMaxLoadMs,
+        stats.mMergeMs / swaps,
+        stats.mMaxMergeMs
+    );
+    stats.Clear();
+    return 0;
+}
+
+// (bench_file_merger file_merger merger file_a file_b swaps) - swaps the merger
+// between two files the way closet browsing does, waiting out each swap, and
+// reports how long they took
+static DataNode OnBenchFileMerger(DataArray *a) {
+    FileMerger *fm = a->Obj<FileMerger>(1);
+    Symbol name = a->Sym(2);
+    FilePath fileA(a->Str(3));
+    FilePath fileB(a->Str(4));
+    int swaps = a->Size() > 5 ? a->Int(5) : 10;
+    gSwapStats.Clear();
+    Timer timer;
+    float totalMs = 0;
+    float maxMs = 0;
+    for (int i = 0; i < swaps; i++) {
+        fm->Select(name, i & 1 ? fileB : fileA, false);
+        timer.Restart();
+        fm->StartLoad(true);
+        while (!fm->mFilesPending.empty()) {
+            TheLoadMgr.Poll();
+        }
+        float ms = timer.SplitMs();
+        totalMs += ms;
+        MaxEq(maxMs, ms);
+    }
+    MILO_LOG(
+        "bench_file_merger: %d swaps of %s, %.1f ms avg, %.1f ms max\n",
+        swaps,
+        name.Str(),
+        totalMs / Max(swaps, 1),
+        maxMs
+    );
+    return OnFileMergerStats(a);
+}
+#endif
+
+void FileMerger::Init() {
+    REGISTER_OBJ_FACTORY(FileMerger)
+#ifdef MILO_DEBUG
+    DataRegisterFunc("file_merger_stats", OnFileMergerStats);
+    DataRegisterFunc("bench_file_merger", OnBenchFileMerger);
+#endif
+}
+
 bool FileMerger::OriginalPath(Hmx::Object *o, String &s) {
     Merger *m = InMerger(o);
     if (m) {
@@ -7,6 +7,7 @@
 #include "obj/Utl.h"
 #include "obj/ObjPtr_p.h"
 #include "utl/Std.h"
+#include "os/Timer.h"
 
 class OriginalPathable {
 public:
@@ -119,7 +120,11 @@ public:
     int FindMergerIndex(Symbol, bool);
     Merger *FindMerger(Symbol, bool);
     bool NeedsLoading(Merger &);
+    /** Whether the merger is in mFilesPending, loading or queued. */
+    bool IsPending(Merger &);
     void AppendLoader(Merger &);
+    /** Drop a pending load, keeping whatever the merger has merged now. */
+    void CancelLoad(Merger &);
     void LaunchNextLoader();
     Merger *InMerger(Hmx::Object *);
     void DeleteCurLoader();
@@ -141,7 +146,7 @@ public:
     NEW_OVERLOAD;
     DELETE_OVERLOAD;
     NEW_OBJ(FileMerger)
-    static void Init() { REGISTER_OBJ_FACTORY(FileMerger) }
+    static void Init();
 
     ObjVector<Merger VECTOR_SIZE_LARGE> mMergers; // 0x30
     bool mAsyncLoad; // 0x40
@@ -151,4 +156,10 @@ public:
     MergeFilter *mFilter; // 0x50
     int mHeap; // 0x54
     Loader::Callback *mOrganizer; // 0x58
+#ifdef MILO_DEBUG
+    /** Times the current load, from launch to merge. Timer holds a long long,
+     * so it is 8 aligned, after 4 bytes of padding at 0x5c.
+     */
+    Timer mSwapTimer; // 0x60
+#endif
 };
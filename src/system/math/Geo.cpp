@@ -3,6 +3,7 @@
 #include "math/Rot.h"
 #include "obj/DataFunc.h"
 #include "decomp.h"
+#include <algorithm>
 
 float gBSPPosTol = 0.01f;
 float gBSPDirTol = 0.985f;
@@ -56,6 +57,110 @@ void Box::GrowToContain(const Vector3 &vec, bool b) {
         }
 }
 
+namespace {
+    // most triangles a TriBVH leaf holds
+    const int kLeafTris = 4;
+
+    void GrowToContain(Box &box, const Box &other) {
+        for (int i = 0; i < 3; i++) {
+            MinEq(box.mMin[i], other.mMin[i]);
+            MaxEq(box.mMax[i], other.mMax[i]);
+        }
+    }
+
+    struct CenterLess {
+        CenterLess(const std::vector<Vector3> &centers, int axis)
+            : mCenters(centers), mAxis(axis) {}
+        bool operator()(int a, int b) const {
+            return mCenters[a][mAxis] < mCenters[b][mAxis];
+        }
+        const std::vector<Vector3> &mCenters;
+        int mAxis;
+    };
+}
+
+void TriBVH::Build(const std::vector<Box> &triBoxes) {
+    int num = triBoxes.size();
+    mNodes.clear();
+    mTris.resize(num);
+    mDirty = false;
+    if (num == 0)
+        return;
+    std::vector<Vector3> centers(num);
+    for (int i = 0; i < num; i++) {
+        mTris[i] = i;
+        CalcBoxCenter(centers[i], triBoxes[i]);
+    }
+    mNodes.reserve(num / kLeafTris * 2 + 1);
+    BuildNode(triBoxes, centers, 0, num);
+}
+
+int TriBVH::BuildNode(
+    const std::vector<Box> &triBoxes,
+    const std::vector<Vector3> &centers,
+    int first,
+    int count
+) {
+    int idx = mNodes.size();
+    mNodes.push_back(Node());
+    Box box = triBoxes[mTris[first]];
+    Box centerBox(centers[mTris[first]], centers[mTris[first]]);
+    for (int i = first + 1; i < first + count; i++) {
+        GrowToContain(box, triBoxes[mTris[i]]);
+        Box center(centers[mTris[i]], centers[mTris[i]]);
+        GrowToContain(centerBox, center);
+    }
+    mNodes[idx].mBox = box;
+    if (count <= kLeafTris) {
+        mNodes[idx].mIndex = first;
+        mNodes[idx].mCount = count;
+        mNodes[idx].mAxis = 0;
+        return idx;
+    }
+    Vector3 extent;
+    Subtract(centerBox.mMax, centerBox.mMin, extent);
+    int axis = 0;
+    if (extent.y > extent[axis])
+        axis = 1;
+    if (extent.z > extent[axis])
+        axis = 2;
+    // median split, so the tree stays balanced however the triangles bunch up
+    int half = count / 2;
+    std::nth_element(
+        mTris.begin() + first,
+        mTris.begin() + first + half,
+        mTris.begin() + first + count,
+        CenterLess(centers, axis)
+    );
+    BuildNode(triBoxes, centers, first, half);
+    int right = BuildNode(triBoxes, centers, first + half, count - half);
+    mNodes[idx].mIndex = right;
+    mNodes[idx].mCount = 0;
+    mNodes[idx].mAxis = axis;
+    return idx;
+}
+
+void TriBVH::Refit(const std::vector<Box> &triBoxes) {
+    if (triBoxes.size() != mTris.size()) {
+        Build(triBoxes);
+        return;
+    }
+    // children always come after their parents
+    for (int i = mNodes.size() - 1; i >= 0; i--) {
+        Node &node = mNodes[i];
+        if (node.mCount) {
+            node.mBox = triBoxes[mTris[node.mIndex]];
+            for (int j = 1; j < node.mCount; j++) {
+                GrowToContain(node.mBox, triBoxes[mTris[node.mIndex + j]]);
+            }
+        } else {
+            node.mBox = mNodes[i + 1].mBox;
+            GrowToContain(node.mBox, mNodes[node.mIndex].mBox);
+        }
+    }
+    mDirty = false;
+}
+
 void Intersect(const Hmx::Ray &r1, const Hmx::Ray &r2, Vector2 &out) {
     float fVar1;
     float fVar2;
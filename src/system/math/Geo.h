@@ -3,7 +3,9 @@
 #include "math/Mtx.h"
 #include "math/Vec.h"
 #include "math/Sphere.h"
+#include "math/Utl.h"
 #include "utl/BinStream.h"
+#include <vector>
 
 class Segment {
 public:
@@ -73,6 +75,122 @@ inline BinStream &operator>>(BinStream &bs, Box &box) {
     return bs;
 }
 
+/**
+ * @brief Flattened bounding volume hierarchy over a list of triangles.
+ *
+ * Nodes are laid out depth first in one vector, each left child right after its
+ * parent, so a query walks memory forwards instead of chasing pointers like the
+ * BSPNode trees do. Leaves hold runs of mTris, the owner's triangle indices.
+ * When the triangles move but keep their topology, Refit recomputes the boxes
+ * without rebuilding.
+ */
+class TriBVH {
+public:
+    struct Node {
+        Box mBox; // 0x0
+        /** A leaf's first entry in mTris, or an inner node's right child. */
+        int mIndex; // 0x18
+        /** How many triangles a leaf holds, 0 for an inner node. */
+        short mCount; // 0x1c
+        /** The axis an inner node split its triangles' centers on. */
+        short mAxis; // 0x1e
+    };
+
+    TriBVH() : mDirty(false), mLastUsed(0) {}
+
+    /** Build over triangles with the given bounding boxes. */
+    void Build(const std::vector<Box> &triBoxes);
+    /** Recompute every node's box from new triangle boxes, rebuilding instead if
+     * the number of triangles changed. */
+    void Refit(const std::vector<Box> &triBoxes);
+
+    /** Call test(tri, seg) for each triangle in a leaf seg crosses, nearer leaves
+     * first. test may pull seg.end in to a hit, which culls everything behind it;
+     * seg must only ever get shorter along its original direction.
+     */
+    template <class T>
+    void Walk(Segment &seg, T &test) const {
+        if (mNodes.empty())
+            return;
+        Vector3 dir;
+        Subtract(seg.end, seg.start, dir);
+        Vector3 inv;
+        int axis = 0;
+        for (int i = 0; i < 3; i++) {
+            // a huge finite inverse keeps flat axes out of 0 * inf
+            inv[i] = dir[i] != 0 ? 1.0f / dir[i] : 1e30f;
+            if (std::fabs(dir[i]) > std::fabs(dir[axis]))
+                axis = i;
+        }
+        float limit = 1.0f;
+        // Build splits at the median, so the depth is about log2 of the leaf
+        // count and 64 entries is far more than any mesh needs
+        int stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node &node = mNodes[stack[--top]];
+            if (!Overlaps(node.mBox, seg.start, inv, limit))
+                continue;
+            if (node.mCount) {
+                for (int i = 0; i < node.mCount; i++) {
+                    test(mTris[node.mIndex + i], seg);
+                }
+                if (dir[axis] != 0)
+                    limit = (seg.end[axis] - seg.start[axis]) * inv[axis];
+            } else {
+                int left = &node - &mNodes.front() + 1;
+                // push the far child first so the near one is tested first
+                if (dir[node.mAxis] < 0) {
+                    stack[top++] = left;
+                    stack[top++] = node.mIndex;
+                } else {
+                    stack[top++] = node.mIndex;
+                    stack[top++] = left;
+                }
+            }
+        }
+    }
+
+    /** Whether start + t * dir, 0 <= t <= limit, crosses box; inv is 1 / dir. */
+    static bool
+    Overlaps(const Box &box, const Vector3 &start, const Vector3 &inv, float limit) {
+        float tmin = 0;
+        float tmax = limit;
+        for (int i = 0; i < 3; i++) {
+            float t0 = (box.mMin[i] - start[i]) * inv[i];
+            float t1 = (box.mMax[i] - start[i]) * inv[i];
+            if (t0 > t1) {
+                float t = t0;
+                t0 = t1;
+                t1 = t;
+            }
+            if (t0 > tmin)
+                tmin = t0;
+            if (t1 < tmax)
+                tmax = t1;
+            if (tmin > tmax)
+                return false;
+        }
+        return true;
+    }
+
+    int Bytes() const {
+        return mNodes.size() * sizeof(Node) + mTris.size() * sizeof(int);
+    }
+
+    std::vector<Node> mNodes;
+    /** Triangle indices, in leaf order. */
+    std::vector<int> mTris;
+    /** The triangles moved since the boxes were last computed. */
+    bool mDirty;
+    /** When the owner last used it, for freeing the least recently used. */
+    int mLastUsed;
+
+private:
+    int BuildNode(const std::vector<Box> &, const std::vector<Vector3> &, int, int);
+};
+
 class BuildPoly {
 public:
     Hmx::Polygon p; // 0x0
@@ -124,6 +124,21 @@ void InterpVector(
     InterpVector(keys, prev, next, ref, spline, vref, vptr);
 }
 
+void InterpVector(
+    const Keys<Vector3, Vector3> &keys,
+    bool spline,
+    float frame,
+    Vector3 &vref,
+    Vector3 *vptr,
+    int &cursor
+) {
+    const Key<Vector3> *prev;
+    const Key<Vector3> *next;
+    float ref;
+    keys.AtFrame(frame, prev, next, ref, cursor);
+    InterpVector(keys, prev, next, ref, spline, vref, vptr);
+}
+
 void QuatSpline(
     const Keys<Hmx::Quat, Hmx::Quat> &keys,
     const Key<Hmx::Quat> *prev,
@@ -232,6 +232,88 @@ public:
         }
     }
 
+    /** AtFrame, searching from a cursor instead of the whole vector.
+     * @param [in,out] cursor The consumer's cursor, see KeyLessEq(float, int &).
+     */
+    int AtFrame(
+        float frame, const Key<T1> *&prev, const Key<T1> *&next, float &ref, int &cursor
+    ) const {
+        if (empty()) {
+            next = 0;
+            prev = 0;
+            ref = 0.0f;
+            return -1;
+        } else {
+            const Key<T1> *frontKey = &front();
+            if (frame < frontKey->frame) {
+                next = frontKey;
+                prev = frontKey;
+                ref = 0.0f;
+                cursor = -1;
+                return -1;
+            } else if (frame >= back().frame) {
+                const Key<T1> *backKey = &back();
+                next = backKey;
+                prev = backKey;
+                ref = 0.0f;
+                cursor = size() - 1;
+                return cursor;
+            } else {
+                int frameIdx = KeyLessEq(frame, cursor);
+                prev = &(*this)[frameIdx];
+                next = &(*this)[frameIdx + 1];
+                float den = next->frame - prev->frame;
+                MILO_ASSERT(den != 0, 0xE9);
+                ref = (frame - prev->frame) / den;
+                return frameIdx;
+            }
+        }
+    }
+
+    /** AtFrame, interpolating the value, searching from a cursor. */
+    int AtFrame(float frame, T2 &val, int &cursor) const {
+        const Key<T1> *prev;
+        const Key<T1> *next;
+        float r;
+        int ret = AtFrame(frame, prev, next, r, cursor);
+        if (prev) {
+            Interp(prev->value, next->value, r, val);
+        }
+        return ret;
+    }
+
+    /** KeyLessEq for a consumer that evaluates the keys frame after frame. The cursor
+     * holds the index its last search returned; a frame within a few keys of it is
+     * found by stepping from there, anything else by the usual bisection.
+     * @param [in] frame The supplied frame.
+     * @param [in,out] cursor The index the consumer's last search returned. Anything
+     * out of range, such as a fresh -1, just means there is no hint.
+     * @returns The same index KeyLessEq(frame) would.
+     */
+    int KeyLessEq(float frame, int &cursor) const {
+        int n = size();
+        int idx = cursor;
+        if (idx >= 0 && idx < n) {
+            const Key<T1> *keys = &front();
+            int steps = 4;
+            while (steps > 0 && idx + 1 < n && !(frame < keys[idx + 1].frame)) {
+                idx++;
+                steps--;
+            }
+            while (steps > 0 && idx >= 0 && frame < keys[idx].frame) {
+                idx--;
+                steps--;
+            }
+            if ((idx < 0 || !(frame < keys[idx].frame))
+                && (idx + 1 >= n || frame < keys[idx + 1].frame)) {
+                cursor = idx;
+                return idx;
+            }
+        }
+        cursor = KeyLessEq(frame);
+        return cursor;
+    }
+
     /** Get the index of the last possible keyframe KF, such that KF's frame <= the
      * supplied frame.
      * @param [in] frame The supplied frame.
@@ -421,9 +503,25 @@ void ScaleFrame(Keys<T1, T2> &keys, float scale) {
     }
 }
 
+/** Evaluate n channels at the same frame: vals[i] from *keys[i], searched from
+ * cursors[i]. A channel with as many keys as the one before it tries that
+ * channel's landing index first, so tracks keyed together share one search.
+ */
+template <class T1, class T2>
+void AtFrames(
+    const Keys<T1, T2> *const *keys, int n, float frame, int *cursors, T2 *vals
+) {
+    for (int i = 0; i < n; i++) {
+        if (i > 0 && keys[i]->size() == keys[i - 1]->size())
+            cursors[i] = cursors[i - 1];
+        keys[i]->AtFrame(frame, vals[i], cursors[i]);
+    }
+}
+
 // math functions defined in math/Key.cpp:
 void SplineTangent(const Keys<Vector3, Vector3> &, int, Vector3 &);
 void InterpTangent(const Vector3 &, const Vector3 &, const Vector3 &, const Vector3 &, float, Vector3 &);
 void InterpVector(const Keys<Vector3, Vector3> &, const Key<Vector3> *, const Key<Vector3> *, float, bool, Vector3 &, Vector3 *);
 void InterpVector(const Keys<Vector3, Vector3> &, bool, float, Vector3 &, Vector3 *);
+void InterpVector(const Keys<Vector3, Vector3> &, bool, float, Vector3 &, Vector3 *, int &cursor);
 void QuatSpline(const Keys<Hmx::Quat, Hmx::Quat> &, const Key<Hmx::Quat> *, const Key<Hmx::Quat> *, float, Hmx::Quat &);
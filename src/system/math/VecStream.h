@@ -0,0 +1,138 @@
+#pragma once
+#include "math/Mtx.h"
+#include "math/Vec.h"
+#include "decomp.h"
+
+// Kernels over contiguous float streams (packed Vector3s, rot channels, quats),
+// two floats at a time with paired singles on target.
+
+#if defined(__MWERKS__) && !defined(DECOMP_IDE_FLAG)
+#define PAIRED_SINGLES 1
+#else
+#define PAIRED_SINGLES 0
+#endif
+
+// how many float pairs of an n float stream the paired loops handle; any odd
+// float, or the whole stream off target, goes through the scalar tail
+#define STREAM_PAIRS(n) (PAIRED_SINGLES ? (n) >> 1 : 0)
+
+/** dst[i] = dst[i] * a + src[i] * b, over n floats. */
+inline void StreamLerp(
+    register float *dst,
+    register const float *src,
+    int n,
+    register float a,
+    register float b
+) {
+    int pairs = STREAM_PAIRS(n);
+    for (int i = 0; i < pairs; i++) {
+        register __vec2x32float__ d;
+        register __vec2x32float__ s;
+        ASM_BLOCK(
+            psq_l d, 0(dst), 0, 0
+            psq_l s, 0(src), 0, 0
+            ps_muls0 s, s, b
+            ps_madds0 d, d, a, s
+            psq_st d, 0(dst), 0, 0
+        )
+        dst += 2;
+        src += 2;
+    }
+    for (int i = pairs * 2; i < n; i++) {
+        *dst = *dst * a + *src * b;
+        dst++;
+        src++;
+    }
+}
+
+/** dst[i] *= f, over n floats. */
+inline void StreamScale(register float *dst, int n, register float f) {
+    int pairs = STREAM_PAIRS(n);
+    for (int i = 0; i < pairs; i++) {
+        register __vec2x32float__ d;
+        ASM_BLOCK(
+            psq_l d, 0(dst), 0, 0
+            ps_muls0 d, d, f
+            psq_st d, 0(dst), 0, 0
+        )
+        dst += 2;
+    }
+    for (int i = pairs * 2; i < n; i++) {
+        *dst++ *= f;
+    }
+}
+
+/** out[i] = the least of sphere i's center distance plus radius over the six planes
+ * of f, below zero when the sphere lies wholly outside one of them.  The spheres
+ * are given as separate x, y, z and radius streams of n floats.
+ */
+inline void StreamCullSpheres(
+    register const float *x,
+    register const float *y,
+    register const float *z,
+    register const float *r,
+    int n,
+    const Frustum &f,
+    register float *out
+) {
+    static const float kOnes[2] = { 1, 1 };
+    static const float kHuge[2] = { 1.0e30f, 1.0e30f };
+    // the six planes are laid out back to back from front
+    const Plane *planes = &f.front;
+    register const float *ones = kOnes;
+    register const float *huge = kHuge;
+    int pairs = STREAM_PAIRS(n);
+    for (int i = 0; i < pairs; i++) {
+        register __vec2x32float__ px;
+        register __vec2x32float__ py;
+        register __vec2x32float__ pz;
+        register __vec2x32float__ pr;
+        register __vec2x32float__ one;
+        register __vec2x32float__ m;
+        register __vec2x32float__ t;
+        register __vec2x32float__ s;
+        ASM_BLOCK(
+            psq_l px, 0(x), 0, 0
+            psq_l py, 0(y), 0, 0
+            psq_l pz, 0(z), 0, 0
+            psq_l pr, 0(r), 0, 0
+            psq_l one, 0(ones), 0, 0
+            psq_l m, 0(huge), 0, 0
+        )
+        for (int j = 0; j < 6; j++) {
+            register float a = planes[j].a;
+            register float b = planes[j].b;
+            register float c = planes[j].c;
+            register float d = planes[j].d;
+            // m = min(m, a * x + b * y + c * z + d + r), without a branch
+            ASM_BLOCK(
+                ps_madds0 t, px, a, pr
+                ps_madds0 t, py, b, t
+                ps_madds0 t, pz, c, t
+                ps_madds0 t, one, d, t
+                ps_sub s, m, t
+                ps_sel m, s, t, m
+            )
+        }
+        ASM_BLOCK(psq_st m, 0(out), 0, 0)
+        x += 2;
+        y += 2;
+        z += 2;
+        r += 2;
+        out += 2;
+    }
+    for (int i = pairs * 2; i < n; i++) {
+        float m = kHuge[0];
+        for (int j = 0; j < 6; j++) {
+            const Plane &p = planes[j];
+            float t = p.a * *x + p.b * *y + p.c * *z + p.d + *r;
+            if (t < m)
+                m = t;
+        }
+        *out++ = m;
+        x++;
+        y++;
+        z++;
+        r++;
+    }
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include "obj/Data.h"
 #include "utl/VectorSizeDefs.h"
+#include <map>
 #include <vector>
 
 class DataEvent {
@@ -57,6 +58,8 @@ public:
     float *EndPtr(int index);
     void Invert(float);
     void Compact();
+    /** Count the distinct messages held, and the bytes used by events and messages. */
+    void MemStats(int &numMsgs, int &bytes) const;
 
     int CurIndex() const { return mCurIndex; }
     int Size() const { return mSize; }
@@ -69,4 +72,10 @@ public:
     mutable DataEvent mTemplate; // 0x20, 0x24, 0x28
     DataType mCompType; // 0x2c
     int *mValue; // 0x30
+    /** Messages inserted since the last Compact, keyed by content hash, so that
+     * identical messages share one array instead of each event owning a copy. */
+    std::multimap<unsigned int, DataArray *> mSharedMsgs; // 0x34
+
+private:
+    DataArray *ShareMsg(DataArray *msg);
 };
@@ -16,6 +16,42 @@ namespace {
             return e.start < f ? true : false;
         }
     };
+
+    // only flat messages of plain values can be shared; anything holding
+    // arrays, strings or variables may be evaluated differently per event
+    bool HashMsg(DataArray *msg, unsigned int &hash) {
+        hash = msg->Size();
+        for (int i = 0; i < msg->Size(); i++) {
+            const DataNode &n = msg->Node(i);
+            switch (n.Type()) {
+            case kDataInt:
+            case kDataFloat:
+            case kDataSymbol:
+                hash = hash * 31 + n.Type();
+                hash = hash * 31 + n.mValue.integer;
+                break;
+            default:
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool SameMsg(DataArray *a, DataArray *b) {
+        if (a->Size() != b->Size())
+            return false;
+        for (int i = 0; i < a->Size(); i++) {
+            const DataNode &na = a->Node(i);
+            const DataNode &nb = b->Node(i);
+            if (na.Type() != nb.Type() || na.mValue.integer != nb.mValue.integer)
+                return false;
+        }
+        return true;
+    }
+
+    int MsgBytes(DataArray *msg) {
+        return sizeof(DataArray) + msg->Size() * sizeof(DataNode);
+    }
 }
 
 DataEventList::DataEventList()
@@ -35,7 +71,7 @@ void DataEventList::InsertEvent(float start, float end, const DataNode &node, in
     if (mElement < 0) {
         if (mSize == 0)
             mEvents.reserve(32);
-        DataEvent d(start, end, node.Array());
+        DataEvent d(start, end, ShareMsg(node.Array()));
         mEvents.insert(mEvents.begin() + idx, d);
     } else {
         CompEv event;
@@ -64,6 +100,21 @@ void DataEventList::InsertEvent(float start, float end, const DataNode &node, in
     mSize++;
 }
 
+DataArray *DataEventList::ShareMsg(DataArray *msg) {
+    unsigned int hash;
+    if (!msg || !HashMsg(msg, hash))
+        return msg;
+    typedef std::multimap<unsigned int, DataArray *>::iterator SharedIt;
+    std::pair<SharedIt, SharedIt> range = mSharedMsgs.equal_range(hash);
+    for (SharedIt it = range.first; it != range.second; ++it) {
+        if (SameMsg(it->second, msg))
+            return it->second;
+    }
+    // not ref counted: every entry is also held by an event until Clear
+    mSharedMsgs.insert(std::make_pair(hash, msg));
+    return msg;
+}
+
 int DataEventList::FindStartFromBack(float start) const {
     int ret = mSize - 1;
     if (mElement < 0) {
@@ -164,6 +215,7 @@ void DataEventList::SecOffset(float fff) {
 }
 
 void DataEventList::Compact() {
+    mSharedMsgs.clear();
     if (mElement < 0) {
         MILO_ASSERT(mComps.empty(), 0x104);
         TrimExcess(mEvents);
@@ -178,4 +230,30 @@ void DataEventList::Clear() {
     mSize = 0;
     ClearAndShrink(mComps);
     ClearAndShrink(mEvents);
+    mSharedMsgs.clear();
+}
+
+void DataEventList::MemStats(int &numMsgs, int &bytes) const {
+    bytes = sizeof(DataEventList) + mEvents.capacity() * sizeof(DataEvent)
+        + mComps.capacity() * sizeof(CompEv);
+    numMsgs = 0;
+    if (mElement >= 0) {
+        if (mTemplate.Msg()) {
+            numMsgs = 1;
+            bytes += MsgBytes(mTemplate.Msg());
+        }
+        return;
+    }
+    std::vector<DataArray *> msgs;
+    msgs.reserve(mEvents.size());
+    for (int i = 0; i < mEvents.size(); i++) {
+        if (mEvents[i].Msg())
+            msgs.push_back(mEvents[i].Msg());
+    }
+    std::sort(msgs.begin(), msgs.end());
+    msgs.erase(std::unique(msgs.begin(), msgs.end()), msgs.end());
+    numMsgs = msgs.size();
+    for (int i = 0; i < msgs.size(); i++) {
+        bytes += MsgBytes(msgs[i]);
+    }
 }
@@ -1,6 +1,7 @@
 #include "MidiParser.h"
 #include "math/Utl.h"
 #include "obj/Data.h"
+#include "obj/DataFunc.h"
 #include "obj/Dir.h"
 #include "os/Debug.h"
 #include "utl/TimeConversion.h"
@@ -44,8 +45,20 @@ void MidiParser::ClearManagedParsers() {
     }
 }
 
+#ifdef MILO_DEBUG
+// (midi_parser_stats) - event and memory totals for the loaded song's parsers
+static DataNode OnMidiParserStats(DataArray *) {
+    if (TheMidiParserMgr)
+        TheMidiParserMgr->DumpStats();
+    return 0;
+}
+#endif
+
 void MidiParser::Init() {
     MidiParser::Register();
+#ifdef MILO_DEBUG
+    DataRegisterFunc("midi_parser_stats", OnMidiParserStats);
+#endif
     MidiParser::mpStart = &DataVariable("mp.start");
     MidiParser::mpEnd = &DataVariable("mp.end");
     MidiParser::mpLength = &DataVariable("mp.length");
@@ -129,6 +142,14 @@ void MidiParser::SetTypeDef(DataArray *arr) {
             );
             DataArray *allowedArr = arr->FindArray("allowed_notes", false);
             mAllowedNotes = allowedArr ? allowedArr->Array(1) : nullptr;
+            memset(mAllowedNoteMask, 0, sizeof(mAllowedNoteMask));
+            if (mAllowedNotes) {
+                for (int i = 0; i < mAllowedNotes->Size(); i++) {
+                    int note = mAllowedNotes->Int(i);
+                    if (note >= 0 && note < 128)
+                        mAllowedNoteMask[note >> 5] |= 1 << (note & 31);
+                }
+            }
             if (!mNoteParser && mAllowedNotes)
                 MILO_FAIL("%s has no midi parser but has allowed_notes", Name());
         }
@@ -183,13 +204,10 @@ bool MidiParser::InsertIdle(float f, int i) {
 bool MidiParser::AllowedNote(int note) {
     if (!mAllowedNotes)
         return true;
-    else {
-        for (int i = 0; i < mAllowedNotes->Size(); i++) {
-            if (note == mAllowedNotes->Int(i))
-                return true;
-        }
+    else if (note < 0 || note >= 128)
         return false;
-    }
+    else
+        return mAllowedNoteMask[note >> 5] & 1 << (note & 31);
 }
 
 void MidiParser::ParseNote(int startTick, int endTick, unsigned char data1) {
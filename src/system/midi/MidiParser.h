@@ -153,6 +153,8 @@ private:
     int mVocalIndex; // 0xa4
     float mStart; // 0xa8
     int mBefore; // 0xac
+    /** mAllowedNotes as one bit per midi note, so ParseNote needn't walk the array. */
+    unsigned int mAllowedNoteMask[4]; // 0xb0
 
     static DataNode *mpStart;
     static DataNode *mpEnd;
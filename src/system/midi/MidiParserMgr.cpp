@@ -4,6 +4,7 @@
 #include "obj/DataFile.h"
 #include "obj/Dir.h"
 #include "midi/MidiParser.h"
+#include "os/Timer.h"
 #include "utl/TimeConversion.h"
 #include "beatmatch/GemListInterface.h"
 #include "utl/Symbols.h"
@@ -19,7 +20,7 @@ inline DataArray *MidiParserArray() {
 
 MidiParserMgr::MidiParserMgr(GemListInterface *gListInt, Symbol sym)
     : mGems(gListInt), mLoaded(0), mFilename(0), mTrackName(), mSongName(), mTrackNames(),
-      unk58(true), unk59(true) {
+      unk58(true), unk59(true), mParseMs(0) {
     MILO_ASSERT(!TheMidiParserMgr, 0x27);
     TheMidiParserMgr = this;
     SetName("midiparsermgr", ObjectDir::sMainDir);
@@ -94,6 +95,8 @@ void MidiParserMgr::OnEndOfTrack() {
         }
         if (mGems)
             mGems->SetTrack(mTrackName);
+        Timer timer;
+        timer.Restart();
         FOREACH_CONST (it, MidiParser::sParsers) {
             MidiParser *cur = *it;
             if (cur->TrackName() == mTrackName) {
@@ -109,6 +112,7 @@ void MidiParserMgr::OnEndOfTrack() {
                 }
             }
         }
+        mParseMs += timer.SplitMs();
         FreeAllData();
         mTrackName = Symbol("");
     }
@@ -267,6 +271,35 @@ MidiParser *MidiParserMgr::GetParser(Symbol s) {
     return nullptr;
 }
 
+void MidiParserMgr::DumpStats() {
+    int totalEvents = 0;
+    int totalMsgs = 0;
+    int totalBytes = 0;
+    FOREACH_CONST (it, MidiParser::sParsers) {
+        MidiParser *cur = *it;
+        int numMsgs, bytes;
+        cur->Events()->MemStats(numMsgs, bytes);
+        MILO_LOG(
+            "  %-24s %6d events %6d messages %8d bytes\n",
+            cur->Name(),
+            cur->Events()->Size(),
+            numMsgs,
+            bytes
+        );
+        totalEvents += cur->Events()->Size();
+        totalMsgs += numMsgs;
+        totalBytes += bytes;
+    }
+    MILO_LOG(
+        "%s: %d events, %d messages, %d bytes, %.2f ms parsing\n",
+        mSongName.Str(),
+        totalEvents,
+        totalMsgs,
+        totalBytes,
+        mParseMs
+    );
+}
+
 BEGIN_PROPSYNCS(MidiParserMgr)
     SYNC_PROP(song_name, mSongName)
 END_PROPSYNCS
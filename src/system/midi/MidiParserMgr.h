@@ -30,6 +30,8 @@ public:
     /** Get the parser with the supplied name. */
     MidiParser *GetParser(Symbol name);
     const char *GetSongName() const { return mSongName.Str(); }
+    /** Print each parser's event count, message count and memory use. */
+    void DumpStats();
 
 private:
     /** Strip the end bracket from the input string. (i.e. remove the ']')
@@ -62,6 +64,8 @@ private:
     std::vector<Symbol> mTrackNames; // 0x50
     bool unk58; // 0x58
     bool unk59; // 0x59
+    /** Time spent in MidiParser::ParseAll for this song. */
+    float mParseMs; // 0x5c
 };
 
 extern MidiParserMgr *TheMidiParserMgr;
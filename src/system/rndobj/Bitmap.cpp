@@ -1,7 +1,10 @@
 #include "Bitmap.h"
 #include "decomp.h"
+#include "math/Utl.h"
+#include "obj/DataFunc.h"
 #include "os/Debug.h"
 #include "os/Endian.h"
+#include "os/Timer.h"
 #include "utl/BinStream.h"
 #include "utl/BufStream.h"
 #include "utl/ChunkStream.h"
@@ -546,6 +549,26 @@ void RndBitmap::SetPreMultipliedAlpha() {
             }
         }
     } else {
+        if (LinearRows() && !(mOrder & 2)) {
+            // a row at a time, since halved alpha would lose a bit going through
+            // RowColors and back
+            unsigned char *row = (unsigned char *)_MemAllocTemp(mWidth * 4, 0);
+            for (int i = 0; i < mHeight; i++) {
+                RowColors(0, i, mWidth, row);
+                bool changed = false;
+                unsigned char *px = row;
+                for (int j = 0; j < mWidth; j++, px += 4) {
+                    if (px[3] != 255) {
+                        PreMultiplyAlpha(px[0], px[1], px[2], px[3]);
+                        changed = true;
+                    }
+                }
+                if (changed)
+                    SetRowColors(0, i, mWidth, row);
+            }
+            _MemFree(row);
+            return;
+        }
         for (int i = 0; i < mHeight; i++) {
             for (int j = 0; j < mWidth; j++) {
                 unsigned char r, g, b, a;
@@ -601,37 +624,58 @@ void RndBitmap::GenerateMips() {
         RELEASE(mMip);
         mMip = new RndBitmap();
         mMip->Create(mWidth >> 1, mHeight >> 1, 0, mBpp, mOrder, mPalette, 0, 0);
-        int i18 = 0;
-        for (int i = 0; i < mMip->mHeight; i++) {
-            int i181 = i18 + 1;
-            int i17 = 0;
-            for (int j = 0; j < mMip->mWidth; j++) {
-                int i171 = i17 + 1;
-                unsigned char r, g, b, a;
-                PixelColor(i17, i18, r, g, b, a);
-                unsigned short rsum = r;
-                unsigned short gsum = g;
-                unsigned short bsum = b;
-                unsigned short asum = a;
-                PixelColor(i171, i18, r, g, b, a);
-                rsum += r;
-                gsum += g;
-                bsum += b;
-                asum += a;
-                PixelColor(i17, i181, r, g, b, a);
-                rsum += r;
-                gsum += g;
-                bsum += b;
-                asum += a;
-                PixelColor(i171, i181, r, g, b, a);
-                rsum += r;
-                gsum += g;
-                bsum += b;
-                asum += a;
-                mMip->SetPixelColor(j, i, rsum >> 2, gsum >> 2, bsum >> 2, asum >> 2);
-                i17 += 2;
+        if (LinearRows()) {
+            int mipWidth = mMip->mWidth;
+            int srcBytes = mipWidth * 8;
+            unsigned char *rows =
+                (unsigned char *)_MemAllocTemp(srcBytes * 2 + mipWidth * 4, 0);
+            unsigned char *row0 = rows;
+            unsigned char *row1 = rows + srcBytes;
+            unsigned char *out = row1 + srcBytes;
+            for (int i = 0; i < mMip->mHeight; i++) {
+                RowColors(0, i * 2, mipWidth * 2, row0);
+                RowColors(0, i * 2 + 1, mipWidth * 2, row1);
+                // a box filter of each 2x2 block, channel by channel
+                for (int j = 0; j < mipWidth * 4; j++) {
+                    int k = (j & ~3) * 2 + (j & 3);
+                    out[j] = (row0[k] + row0[k + 4] + row1[k] + row1[k + 4]) >> 2;
+                }
+                mMip->SetRowColors(0, i, mipWidth, out);
+            }
+            _MemFree(rows);
+        } else {
+            int i18 = 0;
+            for (int i = 0; i < mMip->mHeight; i++) {
+                int i181 = i18 + 1;
+                int i17 = 0;
+                for (int j = 0; j < mMip->mWidth; j++) {
+                    int i171 = i17 + 1;
+                    unsigned char r, g, b, a;
+                    PixelColor(i17, i18, r, g, b, a);
+                    unsigned short rsum = r;
+                    unsigned short gsum = g;
+                    unsigned short bsum = b;
+                    unsigned short asum = a;
+                    PixelColor(i171, i18, r, g, b, a);
+                    rsum += r;
+                    gsum += g;
+                    bsum += b;
+                    asum += a;
+                    PixelColor(i17, i181, r, g, b, a);
+                    rsum += r;
+                    gsum += g;
+                    bsum += b;
+                    asum += a;
+                    PixelColor(i171, i181, r, g, b, a);
+                    rsum += r;
+                    gsum += g;
+                    bsum += b;
+                    asum += a;
+                    mMip->SetPixelColor(j, i, rsum >> 2, gsum >> 2, bsum >> 2, asum >> 2);
+                    i17 += 2;
+                }
+                i18 += 2;
             }
-            i18 += 2;
         }
         mMip->GenerateMips();
     }
@@ -799,6 +843,21 @@ void RndBitmap::SaveBmpPixels(BinStream *file) const {
 bool RndBitmap::IsTranslucent() const {
     if (mBpp == 24)
         return false;
+    if (LinearRows()) {
+        bool translucent = false;
+        unsigned char *row = (unsigned char *)_MemAllocTemp(mWidth * 4, 0);
+        for (int i = 0; i < mHeight && !translucent; i++) {
+            RowColors(0, i, mWidth, row);
+            for (int j = 3; j < mWidth * 4; j += 4) {
+                if (row[j] < 253) {
+                    translucent = true;
+                    break;
+                }
+            }
+        }
+        _MemFree(row);
+        return translucent;
+    }
     for (int i = 0; i < mHeight; i++) {
         for (int j = 0; j < mWidth; j++) {
             unsigned char r, g, b, a;
@@ -880,6 +939,15 @@ void RndBitmap::Blt(
                     SetPixelIndex(dx, dy, colorBuffer[bm.PixelIndex(sx, sy)]);
                 }
             }
+        } else if (LinearRows() && bm.LinearRows()) {
+            if (width > 0) {
+                unsigned char *row = (unsigned char *)_MemAllocTemp(width * 4, 0);
+                for (int h = height, dy = dY, sy = sY; h > 0; h--, dy++, sy++) {
+                    bm.RowColors(sX, sy, width, row);
+                    SetRowColors(dX, dy, width, row);
+                }
+                _MemFree(row);
+            }
         } else {
             for (int h = height, dy = dY, sy = sY; h > 0; h--, dy++, sy++) {
                 for (int w = width, sx = sX, dx = dX; w > 0; w--, sx++, dx++) {
@@ -918,8 +986,73 @@ void RndBitmap::SetPixelColor(
     }
 }
 
-void DecodeDxtColor(unsigned char *, int, int, bool, unsigned char &, unsigned char &, unsigned char &, unsigned char &) {
+// DXT blocks are read and written a u16 at a time, which SwapDxtEndianness keeps
+// in native order; the index bytes pack two rows to a u16, low row first
+
+// the four colors a DXT color block picks from, as RGBA
+static void DxtPalette(unsigned short c0, unsigned short c1, bool dxt1, u8 pal[4][4]) {
+    unsigned short c[2] = { c0, c1 };
+    for (int i = 0; i < 2; i++) {
+        int r = c[i] >> 11 & 0x1F;
+        int g = c[i] >> 5 & 0x3F;
+        int b = c[i] & 0x1F;
+        pal[i][0] = r << 3 | r >> 2;
+        pal[i][1] = g << 2 | g >> 4;
+        pal[i][2] = b << 3 | b >> 2;
+        pal[i][3] = 255;
+    }
+    for (int ch = 0; ch < 3; ch++) {
+        if (!dxt1 || c0 > c1) {
+            pal[2][ch] = (pal[0][ch] * 2 + pal[1][ch]) / 3;
+            pal[3][ch] = (pal[0][ch] + pal[1][ch] * 2) / 3;
+        } else {
+            pal[2][ch] = (pal[0][ch] + pal[1][ch]) / 2;
+            pal[3][ch] = 0;
+        }
+    }
+    pal[2][3] = 255;
+    pal[3][3] = !dxt1 || c0 > c1 ? 255 : 0;
+}
+
+// the eight alphas a DXT5 alpha block picks from
+static void DxtAlphaPalette(int a0, int a1, u8 pal[8]) {
+    pal[0] = a0;
+    pal[1] = a1;
+    if (a0 > a1) {
+        for (int k = 2; k < 8; k++) {
+            pal[k] = ((8 - k) * a0 + (k - 1) * a1) / 7;
+        }
+    } else {
+        for (int k = 2; k < 6; k++) {
+            pal[k] = ((6 - k) * a0 + (k - 1) * a1) / 5;
+        }
+        pal[6] = 0;
+        pal[7] = 255;
+    }
+}
 
+static u64 DxtAlphaBits(const unsigned short *words) {
+    return words[1] | (u64)words[2] << 16 | (u64)words[3] << 32;
+}
+
+void DecodeDxtColor(
+    unsigned char *uc,
+    int i,
+    int j,
+    bool dxt1,
+    unsigned char &r,
+    unsigned char &g,
+    unsigned char &b,
+    unsigned char &a
+) {
+    unsigned short *words = (unsigned short *)uc;
+    u8 pal[4][4];
+    DxtPalette(words[0], words[1], dxt1, pal);
+    int idx = words[2 + (j >> 1)] >> ((j & 1) * 8 + i * 2) & 3;
+    r = pal[idx][0];
+    g = pal[idx][1];
+    b = pal[idx][2];
+    a = pal[idx][3];
 }
 
 void DecodeDxt3Alpha(unsigned char *uc, int i, int j, unsigned char &alpha) {
@@ -928,7 +1061,96 @@ void DecodeDxt3Alpha(unsigned char *uc, int i, int j, unsigned char &alpha) {
     alpha = ((i1 << 4) & 0xF0) | (i1 & 0xF);
 }
 
-void DecodeDxt5Alpha(unsigned char *, int, int, unsigned char &) {}
+void DecodeDxt5Alpha(unsigned char *uc, int i, int j, unsigned char &alpha) {
+    unsigned short *words = (unsigned short *)uc;
+    u8 pal[8];
+    DxtAlphaPalette(words[0] & 0xFF, words[0] >> 8, pal);
+    alpha = pal[DxtAlphaBits(words) >> ((j * 4 + i) * 3) & 7];
+}
+
+// fits one DXT color block to the 16 RGBA pixels in px with the corners of
+// their bounding box; in DXT1 pixels under half alpha come out transparent
+static void EncodeDxtColor(const unsigned char *px, bool dxt1, unsigned char *out) {
+    int lo[3] = { 255, 255, 255 };
+    int hi[3] = { 0, 0, 0 };
+    bool transparent = false;
+    for (int p = 0; p < 16; p++) {
+        const unsigned char *c = px + p * 4;
+        if (dxt1 && c[3] < 128) {
+            transparent = true;
+            continue;
+        }
+        for (int ch = 0; ch < 3; ch++) {
+            MinEq(lo[ch], (int)c[ch]);
+            MaxEq(hi[ch], (int)c[ch]);
+        }
+    }
+    unsigned short c0 = (hi[0] & 0xF8) << 8 | (hi[1] & 0xFC) << 3 | hi[2] >> 3;
+    unsigned short c1 = (lo[0] & 0xF8) << 8 | (lo[1] & 0xFC) << 3 | lo[2] >> 3;
+    // c0 > c1 picks four colors, otherwise three and transparent
+    if (transparent ? c0 > c1 : c0 < c1) {
+        unsigned short tmp = c0;
+        c0 = c1;
+        c1 = tmp;
+    }
+    u8 pal[4][4];
+    DxtPalette(c0, c1, dxt1, pal);
+    int numColors = !dxt1 || c0 > c1 ? 4 : 3;
+    unsigned short *words = (unsigned short *)out;
+    words[0] = c0;
+    words[1] = c1;
+    words[2] = 0;
+    words[3] = 0;
+    for (int p = 0; p < 16; p++) {
+        const unsigned char *c = px + p * 4;
+        int idx = 3;
+        if (!(dxt1 && c[3] < 128)) {
+            int best = 0x40000;
+            for (int k = 0; k < numColors; k++) {
+                int dr = pal[k][0] - c[0];
+                int dg = pal[k][1] - c[1];
+                int db = pal[k][2] - c[2];
+                int diff = dr * dr + dg * dg + db * db;
+                if (diff < best) {
+                    best = diff;
+                    idx = k;
+                }
+            }
+        }
+        words[2 + (p >> 3)] |= idx << ((p & 7) * 2);
+    }
+}
+
+// fits one DXT5 alpha block to the alphas of the 16 RGBA pixels in px
+static void EncodeDxt5Alpha(const unsigned char *px, unsigned char *out) {
+    int lo = 255;
+    int hi = 0;
+    for (int p = 0; p < 16; p++) {
+        MinEq(lo, (int)px[p * 4 + 3]);
+        MaxEq(hi, (int)px[p * 4 + 3]);
+    }
+    u8 pal[8];
+    DxtAlphaPalette(hi, lo, pal);
+    u64 bits = 0;
+    for (int p = 0; p < 16; p++) {
+        int a = px[p * 4 + 3];
+        int idx = 0;
+        int best = 256;
+        for (int k = 0; k < 8; k++) {
+            int diff = pal[k] > a ? pal[k] - a : a - pal[k];
+            if (diff < best) {
+                best = diff;
+                idx = k;
+            }
+        }
+        bits |= (u64)idx << (p * 3);
+    }
+    unsigned short *words = (unsigned short *)out;
+    words[0] = hi | lo << 8;
+    words[1] = bits;
+    words[2] = bits >> 16;
+    words[3] = bits >> 32;
+}
 
 void RndBitmap::DxtColor(
     int x, int y, unsigned char &r, unsigned char &g, unsigned char &b, unsigned char &a
@@ -956,6 +1178,125 @@ void RndBitmap::DxtColor(
     }
 }
 
+bool RndBitmap::LinearRows() const {
+    return !mPalette && !(mOrder & 0x78) && (mBpp == 32 || mBpp == 24);
+}
+
+void RndBitmap::RowColors(int x, int y, int n, unsigned char *rgba) const {
+    if (!LinearRows()) {
+        for (int i = 0; i < n; i++, rgba += 4) {
+            PixelColor(x + i, y, rgba[0], rgba[1], rgba[2], rgba[3]);
+        }
+        return;
+    }
+    const unsigned char *src = mPixels + y * mRowBytes + x * (mBpp >> 3);
+    if (mBpp == 24) {
+        int r = mOrder & 1 ? 0 : 2;
+        for (int i = 0; i < n; i++, src += 3, rgba += 4) {
+            rgba[0] = src[r];
+            rgba[1] = src[1];
+            rgba[2] = src[2 - r];
+            rgba[3] = 255;
+        }
+        return;
+    }
+    if (mOrder & 1) {
+        memcpy(rgba, src, n * 4);
+    } else {
+        for (int i = 0; i < n; i++, src += 4) {
+            rgba[i * 4] = src[2];
+            rgba[i * 4 + 1] = src[1];
+            rgba[i * 4 + 2] = src[0];
+            rgba[i * 4 + 3] = src[3];
+        }
+    }
+    if (mOrder & 2) {
+        for (int i = 3; i < n * 4; i += 4) {
+            rgba[i] = rgba[i] * 255 >> 7;
+        }
+    }
+}
+
+void RndBitmap::SetRowColors(int x, int y, int n, const unsigned char *rgba) {
+    if (!LinearRows()) {
+        for (int i = 0; i < n; i++, rgba += 4) {
+            SetPixelColor(x + i, y, rgba[0], rgba[1], rgba[2], rgba[3]);
+        }
+        return;
+    }
+    unsigned char *dst = mPixels + y * mRowBytes + x * (mBpp >> 3);
+    if (mBpp == 24) {
+        int r = mOrder & 1 ? 0 : 2;
+        for (int i = 0; i < n; i++, dst += 3, rgba += 4) {
+            dst[r] = rgba[0];
+            dst[1] = rgba[1];
+            dst[2 - r] = rgba[2];
+        }
+        return;
+    }
+    if (mOrder & 1) {
+        memcpy(dst, rgba, n * 4);
+    } else {
+        for (int i = 0; i < n; i++, dst += 4) {
+            dst[0] = rgba[i * 4 + 2];
+            dst[1] = rgba[i * 4 + 1];
+            dst[2] = rgba[i * 4];
+            dst[3] = rgba[i * 4 + 3];
+        }
+        dst -= n * 4;
+    }
+    if (mOrder & 2) {
+        for (int i = 3; i < n * 4; i += 4) {
+            dst[i] = (rgba[i] + 1) >> 1;
+        }
+    }
+}
+
+void RndBitmap::CompressDxt(bool alpha) {
+    if (!LinearRows() || (mWidth | mHeight) & 3) {
+        MILO_FAIL(
+            "Can't compress %dx%d %d bpp bitmap with order %d to DXT",
+            mWidth,
+            mHeight,
+            mBpp,
+            mOrder
+        );
+        return;
+    }
+    int blocksWide = mWidth >> 2;
+    int blockBytes = alpha ? 16 : 8;
+    int bytes = blocksWide * (mHeight >> 2) * blockBytes;
+    unsigned char *blocks = (unsigned char *)_MemAlloc(bytes, 32);
+    unsigned char *rows = (unsigned char *)_MemAllocTemp(mWidth * 16, 0);
+    unsigned char px[64];
+    unsigned char *out = blocks;
+    for (int y = 0; y < mHeight; y += 4) {
+        for (int j = 0; j < 4; j++) {
+            RowColors(0, y + j, mWidth, rows + j * mWidth * 4);
+        }
+        for (int x = 0; x < blocksWide; x++, out += blockBytes) {
+            for (int j = 0; j < 4; j++) {
+                memcpy(px + j * 16, rows + (j * mWidth + x * 4) * 4, 16);
+            }
+            if (alpha) {
+                EncodeDxt5Alpha(px, out);
+                EncodeDxtColor(px, false, out + 8);
+            } else
+                EncodeDxtColor(px, true, out);
+        }
+    }
+    _MemFree(rows);
+    RndBitmap *mip = DetachMip();
+    Create(mWidth, mHeight, 0, alpha ? 8 : 4, alpha ? 0x20 : kDXT1, 0, blocks, blocks);
+    if (mip) {
+        if (mip->Width() >= 4 && mip->Height() >= 4) {
+            mip->CompressDxt(alpha);
+            mMip = mip;
+        } else
+            delete mip;
+    }
+}
+
 int RndBitmap::PaletteOffset(int i) const {
     if ((mOrder & 2) && mBpp == 8) {
         if ((i & 0x18) == 8) {
@@ -1087,4 +1428,173 @@ bool RndBitmap::LoadSafely(BinStream &bs, int w, int h) {
         ReadChunks(bs, cur->Pixels(), cur->PixelBytes(), 0x8000);
     }
     return true;
-}
\ No newline at end of file
+}
+
+#ifdef MILO_DEBUG
+namespace {
+    // the bench's gradient at x, y as RGBA
+    void GradientColor(int x, int y, int w, int h, unsigned char *c) {
+        c[0] = x * 255 / w;
+        c[1] = y * 255 / h;
+        c[2] = (x ^ y) & 0xFF;
+        c[3] = x + y;
+    }
+
+    // pixels of a plain 32 bpp BGRA bitmap that differ from the RGBA in ref,
+    // read straight out of mPixels
+    int Mismatches(const RndBitmap &bm, const unsigned char *ref) {
+        int mismatches = 0;
+        for (int y = 0; y < bm.Height(); y++) {
+            const unsigned char *p = bm.mPixels + y * bm.mRowBytes;
+            for (int x = 0; x < bm.Width(); x++, p += 4, ref += 4) {
+                if (p[2] != ref[0] || p[1] != ref[1] || p[0] != ref[2] || p[3] != ref[3])
+                    mismatches++;
+            }
+        }
+        return mismatches;
+    }
+
+    // pixels of row y that RowColors gets different from the RGBA in ref
+    int RowMismatches(
+        const RndBitmap &bm, int y, const unsigned char *ref, unsigned char *row
+    ) {
+        bm.RowColors(0, y, bm.Width(), row);
+        int mismatches = 0;
+        for (int i = 0; i < bm.Width() * 4; i += 4) {
+            if (memcmp(row + i, ref + i, 4))
+                mismatches++;
+        }
+        return mismatches;
+    }
+
+    // root mean square error per channel of bm against the RGBA in ref
+    float ColorError(const unsigned char *ref, const RndBitmap &bm) {
+        float sum = 0;
+        for (int y = 0; y < bm.Height(); y++) {
+            for (int x = 0; x < bm.Width(); x++, ref += 4) {
+                unsigned char c[4];
+                bm.PixelColor(x, y, c[0], c[1], c[2], c[3]);
+                for (int ch = 0; ch < 4; ch++) {
+                    float diff = ref[ch] - c[ch];
+                    sum += diff * diff;
+                }
+            }
+        }
+        return std::sqrt(sum / (bm.Width() * bm.Height() * 4));
+    }
+
+    float Mps(const RndBitmap &bm, Timer &t) {
+        return t.Ms() > 0 ? bm.Width() * bm.Height() / (t.Ms() * 1000) : 0;
+    }
+
+    // (bench_bitmap width height) - runs a gradient bitmap through the row
+    // reads, mips, premultiply and DXT compression, checks them against
+    // reference pixels written and read straight from mPixels, and reports
+    // megapixels per second
+    DataNode BenchBitmap(DataArray *a) {
+        int w = a->Size() > 1 ? a->Int(1) : 256;
+        int h = a->Size() > 2 ? a->Int(2) : 256;
+        w = Max(w & ~3, 4);
+        h = Max(h & ~3, 4);
+        unsigned char *ref = (unsigned char *)_MemAllocTemp(w * h * 4, 0);
+        RndBitmap src;
+        src.Create(w, h, 0, 32, 0, 0, 0, 0);
+        for (int y = 0; y < h; y++) {
+            unsigned char *p = src.mPixels + y * src.mRowBytes;
+            for (int x = 0; x < w; x++, p += 4) {
+                unsigned char *c = ref + (y * w + x) * 4;
+                GradientColor(x, y, w, h, c);
+                p[0] = c[2];
+                p[1] = c[1];
+                p[2] = c[0];
+                p[3] = c[3];
+            }
+        }
+        Timer timers[6];
+        int mismatches = 0;
+        unsigned char *row = (unsigned char *)_MemAllocTemp(w * 4, 0);
+        timers[0].Start();
+        for (int y = 0; y < h; y++) {
+            mismatches += RowMismatches(src, y, ref + y * w * 4, row);
+        }
+        timers[0].Stop();
+        _MemFree(row);
+
+        RndBitmap mips;
+        mips.Create(src, 32, 0, 0);
+        timers[1].Start();
+        mips.GenerateMips();
+        timers[1].Stop();
+        if (mips.nextMip()) {
+            unsigned char *mipRef = (unsigned char *)_MemAllocTemp(w * h, 0);
+            unsigned char *out = mipRef;
+            for (int y = 0; y < h; y += 2) {
+                for (int x = 0; x < w * 4; x += 8) {
+                    const unsigned char *in = ref + y * w * 4 + x;
+                    for (int ch = 0; ch < 4; ch++, in++) {
+                        *out++ = (in[0] + in[4] + in[w * 4] + in[w * 4 + 4]) >> 2;
+                    }
+                }
+            }
+            mismatches += Mismatches(*mips.nextMip(), mipRef);
+            _MemFree(mipRef);
+        }
+
+        RndBitmap pre;
+        pre.Create(src, 32, 0, 0);
+        timers[2].Start();
+        pre.SetPreMultipliedAlpha();
+        timers[2].Stop();
+        unsigned char *preRef = (unsigned char *)_MemAllocTemp(w * h * 4, 0);
+        memcpy(preRef, ref, w * h * 4);
+        for (int i = 0; i < w * h * 4; i += 4) {
+            if (preRef[i + 3] != 255) {
+                float f = preRef[i + 3] / 255.0f;
+                for (int ch = 0; ch < 3; ch++)
+                    preRef[i + ch] *= f;
+            }
+        }
+        mismatches += Mismatches(pre, preRef);
+        _MemFree(preRef);
+
+        timers[3].Start();
+        bool translucent = src.IsTranslucent();
+        timers[3].Stop();
+        if (!translucent)
+            mismatches++;
+
+        RndBitmap dxt1;
+        dxt1.Create(src, 32, 0, 0);
+        timers[4].Start();
+        dxt1.CompressDxt(false);
+        timers[4].Stop();
+        RndBitmap dxt5;
+        dxt5.Create(src, 32, 0, 0);
+        timers[5].Start();
+        dxt5.CompressDxt(true);
+        timers[5].Stop();
+        MILO_LOG(
+            "bench_bitmap: %dx%d, rows %.1f, mips %.1f, premultiply %.1f, translucent %.1f, dxt1 %.1f, dxt5 %.1f MP/s, dxt1 rmse %.2f, dxt5 rmse %.2f, %d mismatches\n",
+            w,
+            h,
+            Mps(src, timers[0]),
+            Mps(src, timers[1]),
+            Mps(src, timers[2]),
+            Mps(src, timers[3]),
+            Mps(src, timers[4]),
+            Mps(src, timers[5]),
+            ColorError(ref, dxt1),
+            ColorError(ref, dxt5),
+            mismatches
+        );
+        _MemFree(ref);
+        return mismatches == 0;
+    }
+}
+#endif
+
+void RndBitmapInit() {
+#ifdef MILO_DEBUG
+    DataRegisterFunc("bench_bitmap", BenchBitmap);
+#endif
+}
@@ -232,6 +232,21 @@ public:
     void SetPixelColor(
         int x, int y, unsigned char r, unsigned char g, unsigned char b, unsigned char a
     );
+    /** Whether rows are unswizzled 24 or 32 bit pixels, y * mRowBytes apart, that
+     * RowColors can copy whole. */
+    bool LinearRows() const;
+    /** Get the colors of n pixels of row y starting at x, as RGBA bytes.
+     * Same results as PixelColor on each of them, a row at a time.
+     * @param [out] rgba At least n * 4 bytes.
+     */
+    void RowColors(int x, int y, int n, unsigned char *rgba) const;
+    /** Set n pixels of row y starting at x from RGBA bytes, as SetPixelColor would. */
+    void SetRowColors(int x, int y, int n, const unsigned char *rgba);
+    /** Compress this RndBitmap and its mips to DXT1, or DXT5 if alpha is set.
+     * Only for LinearRows bitmaps whose width and height are multiples of 4; mips
+     * smaller than that are dropped.
+     */
+    void CompressDxt(bool alpha);
     /** Load a raw .bmp contained in a BinStream into this RndBitmap.
      * @param [in] bs The BinStream.
      * @returns True if the .bmp was successfully loaded, false if not.
@@ -307,6 +322,9 @@ public:
     DELETE_OVERLOAD
 };
 
+/** Register the bitmap console funcs. */
+void RndBitmapInit();
+
 inline BinStream &operator>>(BinStream &bs, RndBitmap &bm) {
     bm.Load(bs);
     return bs;
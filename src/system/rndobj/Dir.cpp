@@ -9,6 +9,8 @@
 #include "utl/FilePath.h"
 #include "obj/ObjVersion.h"
 #include "obj/DirLoader.h"
+#include "obj/DataFunc.h"
+#include "os/Timer.h"
 #include "rndobj/PostProc.h"
 #include "rndobj/EventTrigger.h"
 #include "rndobj/Utl.h"
@@ -20,6 +22,68 @@ INIT_REVS(RndDir)
 
 DECOMP_FORCEACTIVE(Dir, "", __FILE__)
 
+bool RndDir::sSchedulePolls = true;
+
+#ifdef MILO_DEBUG
+namespace {
+    void PollTimes(RndDir *dir, int frames, std::vector<float> &times) {
+        times.resize(frames);
+        Timer timer;
+        for (int i = 0; i < frames; i++) {
+            timer.Restart();
+            dir->Poll();
+            timer.Stop();
+            times[i] = timer.Ms();
+        }
+        std::sort(times.begin(), times.end());
+    }
+
+    float Percentile(const std::vector<float> &times, float pct) {
+        return times.empty() ? 0 : times[(int)((times.size() - 1) * pct / 100)];
+    }
+
+    // (bench_poll dir frames) - polls dir without drawing for that many frames,
+    // in SortPolls order and then scheduled, and reports the frame times
+    DataNode BenchPoll(DataArray *a) {
+        RndDir *dir = a->Obj<RndDir>(1);
+        int frames = a->Size() > 2 ? a->Int(2) : 300;
+        if (!dir || frames <= 0)
+            return 0;
+        bool oldSchedule = RndDir::sSchedulePolls;
+        for (int pass = 0; pass < 2; pass++) {
+            RndDir::sSchedulePolls = pass == 1;
+            dir->SyncObjects();
+            std::vector<RndPollable *> polls(dir->mPolls);
+            int waves = SchedulePolls(polls);
+            std::vector<float> times;
+            PollTimes(dir, frames, times);
+            MILO_LOG(
+                "bench_poll: %s %s, %d polls in %d waves, frame ms min %.3f median %.3f p95 %.3f p99 %.3f max %.3f\n",
+                dir->Name(),
+                pass == 1 ? "scheduled" : "sorted",
+                polls.size(),
+                waves,
+                times.front(),
+                Percentile(times, 50),
+                Percentile(times, 95),
+                Percentile(times, 99),
+                times.back()
+            );
+        }
+        RndDir::sSchedulePolls = oldSchedule;
+        dir->SyncObjects();
+        return 1;
+    }
+}
+#endif
+
+void RndDir::Init() {
+    REGISTER_OBJ_FACTORY(RndDir)
+#ifdef MILO_DEBUG
+    DataRegisterFunc("bench_poll", BenchPoll);
+#endif
+}
+
 RndDir::RndDir() : mEnv(this, 0) {}
 
 void RndDir::Replace(Hmx::Object *o1, Hmx::Object *o2) {
@@ -74,6 +138,8 @@ void RndDir::SyncObjects() {
             VectorRemove(mPolls, *it);
         }
         std::sort(mPolls.begin(), mPolls.end(), SortPolls);
+        if (sSchedulePolls)
+            SchedulePolls(mPolls);
         if (IsProxy()) {
             MsgSource *src = dynamic_cast<MsgSource *>(Dir());
             if (src)
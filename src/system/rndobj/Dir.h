@@ -97,5 +97,8 @@ public:
     NEW_OVERLOAD;
     DELETE_OVERLOAD;
     NEW_OBJ(RndDir)
-    static void Init() { REGISTER_OBJ_FACTORY(RndDir) }
+    static void Init();
+
+    /** Regroup independent polls with SchedulePolls when syncing objects. */
+    static bool sSchedulePolls;
 };
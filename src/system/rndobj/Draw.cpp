@@ -2,6 +2,8 @@
 #include "rndobj/Cam.h"
 #include "rndobj/Utl.h"
 #include "math/Geo.h"
+#include "math/Utl.h"
+#include "math/VecStream.h"
 #include "obj/PropSync_p.h"
 #include "utl/Symbols.h"
 
@@ -270,3 +272,44 @@ BEGIN_PROPSYNCS(RndDrawable)
     }
     SYNC_PROP(sphere, mSphere);
 END_PROPSYNCS
+
+bool RndDrawList::sBatchCull = true;
+
+void RndDrawList::Add(RndDrawable *draw) {
+    if (!draw || !draw->mShowing)
+        return;
+    Sphere s;
+    if (!draw->MakeWorldSphere(s, false)) {
+        s.center.Zero();
+        s.radius = kHugeFloat;
+    }
+    AddSphere(draw, s);
+}
+
+void RndDrawList::AddSphere(RndDrawable *draw, const Sphere &s) {
+    mDraws.push_back(draw);
+    mX.push_back(s.center.x);
+    mY.push_back(s.center.y);
+    mZ.push_back(s.center.z);
+    mR.push_back(s.radius);
+}
+
+void RndDrawList::Cull(const Frustum &f, int start) {
+    int n = Size() - start;
+    mDists.resize(Size());
+    if (n > 0) {
+        StreamCullSpheres(
+            &mX[start], &mY[start], &mZ[start], &mR[start], n, f, &mDists[start]
+        );
+    }
+}
+
+void RndDrawList::Truncate(int size) {
+    mDraws.resize(size);
+    mX.resize(size);
+    mY.resize(size);
+    mZ.resize(size);
+    mR.resize(size);
+    if (mDists.size() > (unsigned int)size)
+        mDists.resize(size);
+}
@@ -6,6 +6,7 @@
 #include "math/Geo.h"
 #include "utl/MemMgr.h"
 #include <list>
+#include <vector>
 
 class RndCam;
 
@@ -169,3 +170,36 @@ public:
      */
     float mOrder; // 0x1c
 };
+
+/**
+ * @brief A flat list of drawables, culled in batches.
+ *
+ * Keeps the world sphere of each showing drawable in separate x, y, z and
+ * radius arrays so a frustum can cull them two at a time. Ranges appended
+ * from a given start can be culled and truncated on their own, so nested
+ * users can share one list.
+ */
+class RndDrawList {
+public:
+    /** Append draw if it's showing; draws without a world sphere are never culled. */
+    void Add(RndDrawable *draw);
+    /** Append a sphere directly. */
+    void AddSphere(RndDrawable *draw, const Sphere &s);
+    /** Cull everything from start on against f. */
+    void Cull(const Frustum &f, int start = 0);
+    void Truncate(int size);
+    void Clear() { Truncate(0); }
+    int Size() const { return mDraws.size(); }
+    bool Visible(int i) const { return mDists[i] >= 0; }
+
+    std::vector<RndDrawable *> mDraws;
+    std::vector<float> mX;
+    std::vector<float> mY;
+    std::vector<float> mZ;
+    std::vector<float> mR;
+    /** Least distance from the frustum planes plus radius, below zero if culled. */
+    std::vector<float> mDists;
+
+    /** Whether groups cull their draws through a shared list. */
+    static bool sBatchCull;
+};
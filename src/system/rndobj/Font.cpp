@@ -7,6 +7,7 @@
 #include "rndobj/Mat.h"
 #include "math/Rot.h"
 #include "rndobj/Tex.h"
+#include "rndobj/TexStreamer.h"
 #include "types.h"
 #include "utl/BinStream.h"
 #include "utl/MakeString.h"
@@ -22,6 +23,14 @@ const char theChars[96] =
 
 DECOMP_FORCEACTIVE(Font, __FILE__, "textureOwner")
 
+namespace {
+    // cell sizes and glyph widths are measured off the page, so it can't shrink
+    void PinPage(RndMat *mat) {
+        if (mat && mat->GetDiffuseTex())
+            TheTexStreamer.Pin(mat->GetDiffuseTex());
+    }
+}
+
 BinStream &operator>>(BinStream &bs, RndFont::KernInfo &ki) {
     if (RndFont::gRev < 17) {
         char x;
@@ -346,6 +355,7 @@ BEGIN_LOADS(RndFont)
                 mMat = LookupOrCreateMat(buf, Dir());
             }
         }
+        PinPage(mMat);
         if (gRev < 4) {
             float w, h;
             if (gRev < 2) {
@@ -475,6 +485,7 @@ BEGIN_COPYS(RndFont)
     MILO_ASSERT(f, 996);
     COPY_SUPERCLASS(Hmx::Object)
     COPY_MEMBER_FROM(f, mMat)
+    PinPage(mMat);
     COPY_MEMBER_FROM(f, mCellSize)
     COPY_MEMBER_FROM(f, mTexCellSize)
     COPY_MEMBER_FROM(f, mDeprecatedSize)
@@ -554,7 +565,7 @@ END_HANDLERS
 
 BEGIN_PROPSYNCS(RndFont)
     SYNC_PROP_MODIFY_ALT(texture_owner, mTextureOwner, UpdateChars())
-    SYNC_PROP_MODIFY_ALT(mat, mMat, UpdateChars())
+    SYNC_PROP_MODIFY_ALT(mat, mMat, PinPage(mMat); UpdateChars())
     SYNC_PROP_MODIFY_ALT(monospace, mMonospace, UpdateChars())
     SYNC_PROP_MODIFY_ALT(packed, mPacked, UpdateChars())
     SYNC_PROP_SET(cell_width, (int)mCellSize.x, SetCellSize(_val.Int(), mCellSize.y))
@@ -1,7 +1,9 @@
 #include "rndobj/Group.h"
 #include "math/Mtx.h"
+#include "math/Rand.h"
 #include "math/Utl.h"
 #include "obj/Data.h"
+#include "obj/DataFunc.h"
 #include "obj/ObjMacros.h"
 #include "obj/ObjPtr_p.h"
 #include "obj/Object.h"
@@ -9,6 +11,7 @@
 #include "rndobj/Cam.h"
 #include "rndobj/Draw.h"
 #include "rndobj/Env.h"
+#include "rndobj/TexStreamer.h"
 #include "rndobj/Trans.h"
 #include "rndobj/Utl.h"
 #include "utl/Std.h"
@@ -17,6 +20,102 @@
 int GROUP_REV = 14;
 bool gInReplace;
 
+namespace {
+    // groups with fewer draws than this cull them one at a time
+    const int kMinBatchDraws = 8;
+
+    // nested groups append after their parent's range and truncate back to it
+    RndDrawList gDrawList;
+}
+
+#ifdef MILO_DEBUG
+// (bench_draw_list count) - culls count random spheres against a 90 degree
+// frustum in one batch and one plane at a time, reports any that disagree
+static DataNode OnBenchDrawList(DataArray *a) {
+    int count = a->Size() > 1 ? a->Int(1) : 10000;
+    const float kNear = 1;
+    const float kFar = 1000;
+    const float kDiag = 0.70710678f;
+    // looking down +y from the origin, every normal pointing in
+    Frustum f;
+    f.front.a = 0, f.front.b = 1, f.front.c = 0, f.front.d = -kNear;
+    f.back.a = 0, f.back.b = -1, f.back.c = 0, f.back.d = kFar;
+    f.left.a = kDiag, f.left.b = kDiag, f.left.c = 0, f.left.d = 0;
+    f.right.a = -kDiag, f.right.b = kDiag, f.right.c = 0, f.right.d = 0;
+    f.top.a = 0, f.top.b = kDiag, f.top.c = -kDiag, f.top.d = 0;
+    f.bottom.a = 0, f.bottom.b = kDiag, f.bottom.c = kDiag, f.bottom.d = 0;
+    const Plane *planes = &f.front;
+
+    std::vector<Sphere> spheres(count);
+    for (int i = 0; i < count; i++) {
+        spheres[i].Set(
+            Vector3(
+                RandomFloat(-kFar, kFar),
+                RandomFloat(-kFar * 0.1f, kFar * 1.1f),
+                RandomFloat(-kFar, kFar)
+            ),
+            RandomFloat(0.5f, 20)
+        );
+    }
+    Timer timers[3];
+    RndDrawList list;
+    timers[0].Start();
+    for (int i = 0; i < count; i++) {
+        list.AddSphere(nullptr, spheres[i]);
+    }
+    timers[0].Stop();
+    timers[1].Start();
+    list.Cull(f);
+    timers[1].Stop();
+    std::vector<bool> culled(count);
+    timers[2].Start();
+    for (int i = 0; i < count; i++) {
+        bool out = false;
+        for (int j = 0; j < 6 && !out; j++) {
+            out = spheres[i] < planes[j];
+        }
+        culled[i] = out;
+    }
+    timers[2].Stop();
+
+    int mismatches = 0;
+    for (int i = 0; i < count; i++) {
+        // spheres grazing a plane may round either way
+        float dist = list.mDists[i];
+        if (list.Visible(i) == culled[i] && (dist > 0.001f || dist < -0.001f))
+            mismatches++;
+    }
+    int visible = 0;
+    for (int i = 0; i < count; i++) {
+        if (list.Visible(i))
+            visible++;
+    }
+    const char *names[2] = { "batch", "one at a time" };
+    for (int i = 0; i < 2; i++) {
+        MILO_LOG(
+            "bench_draw_list: %s, %.0f spheres/s\n",
+            names[i],
+            timers[i + 1].Ms() > 0 ? count * 1000.0f / timers[i + 1].Ms() : 0.0f
+        );
+    }
+    MILO_LOG(
+        "bench_draw_list: %d spheres, %d visible, %d mismatches, gather %.2f ms\n",
+        count,
+        visible,
+        mismatches,
+        timers[0].Ms()
+    );
+    return mismatches == 0;
+}
+#endif
+
+void RndGroup::Init() {
+    REGISTER_OBJ_FACTORY(RndGroup)
+#ifdef MILO_DEBUG
+    DataRegisterFunc("bench_draw_list", OnBenchDrawList);
+#endif
+}
+
 RndGroup::RndGroup()
     : mObjects(this, kObjListOwnerControl), mEnv(this), mDrawOnly(this), mLod(this),
       mLodScreenSize(0), mDrawLod(0) {
@@ -235,6 +334,10 @@ bool RndGroup::DrawShowingBudget(float f1) {
     RndEnvironTracker tracker(mEnv, &WorldXfm().v);
     if (mDrawOnly) {
         mDrawOnly->Draw();
+    } else if (f1 == kHugeFloat && RndDrawList::sBatchCull
+               && mDraws.size() >= kMinBatchDraws
+               && (mDrawItr == mDraws.begin() || mDrawItr == mDraws.end())) {
+        DrawCulled();
     } else {
         Timer timer;
         timer.Start();
@@ -253,6 +356,28 @@ bool RndGroup::DrawShowingBudget(float f1) {
     return true;
 }
 
+void RndGroup::DrawCulled() {
+    RndCam *cam = RndCam::sCurrent;
+    int start = gDrawList.Size();
+    FOREACH (it, mDraws) {
+        gDrawList.Add(*it);
+    }
+    gDrawList.Cull(cam->mWorldFrustum, start);
+    TheTexStreamer.RequestVisible(gDrawList, cam, start);
+    int end = gDrawList.Size();
+    for (int i = start; i < end; i++) {
+        RndDrawable *draw = gDrawList.mDraws[i];
+        if (RndCam::sCurrent != cam) {
+            // a draw switched cameras, so the batch no longer applies
+            draw->DrawBudget(kHugeFloat);
+        } else if (gDrawList.Visible(i)) {
+            draw->DrawShowingBudget(kHugeFloat);
+        }
+    }
+    gDrawList.Truncate(start);
+    mDrawItr = mDraws.end();
+}
+
 void RndGroup::ListDrawChildren(std::list<RndDrawable *> &children) {
     children.insert(children.end(), mDraws.begin(), mDraws.end());
     if (mLod)
@@ -62,6 +62,10 @@ public:
      * @param [in] obj The object to add.
      */
     void AddObjectAtFront(Hmx::Object *obj);
+    /** Cull every draw against the current camera in one batch, then draw the
+     * survivors in group order.
+     */
+    void DrawCulled();
 
     // weak getters/setters
     RndEnviron *GetEnv() const { return mEnv; }
@@ -76,7 +80,7 @@ public:
     NEW_OVERLOAD;
     DELETE_OVERLOAD;
     NEW_OBJ(RndGroup)
-    static void Init() { REGISTER_OBJ_FACTORY(RndGroup) }
+    static void Init();
 
     /** The objects of this group. */
     ObjPtrList<Hmx::Object> mObjects; // 0xc0
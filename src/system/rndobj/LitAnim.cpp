@@ -4,7 +4,8 @@
 
 int LIGHTANIM_REV = 2;
 
-RndLightAnim::RndLightAnim() : mLight(this, 0), mKeysOwner(this, this) {}
+RndLightAnim::RndLightAnim()
+    : mLight(this, 0), mKeysOwner(this, this), mColorCursor(-1) {}
 
 void RndLightAnim::SetKeysOwner(RndLightAnim *o) {
     MILO_ASSERT(o, 0x27);
@@ -75,7 +76,7 @@ void RndLightAnim::SetFrame(float frame, float blend) {
     if (mLight) {
         if (!ColorKeys().empty()) {
             Hmx::Color ref;
-            ColorKeys().AtFrame(frame, ref);
+            ColorKeys().AtFrame(frame, ref, mColorCursor);
             if (blend != 1.0f) {
                 Interp(mLight->GetColor(), ref, blend, ref);
             }
@@ -36,6 +36,8 @@ public:
     ObjPtr<RndLight, class ObjectDir> mLight; // 0x10
     Keys<Hmx::Color, Hmx::Color> mColorKeys; // 0x1c
     ObjOwnerPtr<RndLightAnim, class ObjectDir> mKeysOwner; // 0x24
+    /** Where the last SetFrame landed in ColorKeys(), for the next search. */
+    int mColorCursor; // 0x30
 };
 
 #endif
@@ -29,7 +29,10 @@ RndMatAnim::TexKeys &RndMatAnim::TexKeys::operator=(const RndMatAnim::TexKeys &k
     }
 }
 
-RndMatAnim::RndMatAnim() : mMat(this), mKeysOwner(this, this), mTexKeys(this) {}
+RndMatAnim::RndMatAnim()
+    : mMat(this), mKeysOwner(this, this), mTexKeys(this), mTransCursor(-1),
+      mRotCursor(-1), mScaleCursor(-1), mTexCursor(-1), mColorCursor(-1),
+      mAlphaCursor(-1) {}
 
 void RndMatAnim::SetMat(RndMat *mat) { mMat = mat; }
 
@@ -169,13 +172,13 @@ void RndMatAnim::SetFrame(float f1, float f2) {
         Transform t58(mMat->TexXfm());
         if (!TransKeys().empty()) {
             if (f2 != 1.0f) {
-                TransKeys().AtFrame(f1, v68);
+                TransKeys().AtFrame(f1, v68, mTransCursor);
                 Interp(t58.v, v68, f2, t58.v);
             } else
-                TransKeys().AtFrame(f1, t58.v);
+                TransKeys().AtFrame(f1, t58.v, mTransCursor);
         }
         if (!RotKeys().empty()) {
-            RotKeys().AtFrame(f1, v68);
+            RotKeys().AtFrame(f1, v68, mRotCursor);
             if (f2 != 1.0f) {
                 Vector3 v80;
                 if (ScaleKeys().empty())
@@ -187,7 +190,7 @@ void RndMatAnim::SetFrame(float f1, float f2) {
             MakeRotMatrix(v68, t58.m, true);
         }
         if (!ScaleKeys().empty()) {
-            ScaleKeys().AtFrame(f1, v68);
+            ScaleKeys().AtFrame(f1, v68, mScaleCursor);
             if (f2 != 1.0f) {
                 Interp(v74, v68, f2, v68);
             }
@@ -198,12 +201,13 @@ void RndMatAnim::SetFrame(float f1, float f2) {
         }
         if (!GetTexKeys().empty()) {
             RndTex *tex;
-            GetTexKeys().AtFrame(f1, tex); // fn_805FBDAC - AtFrame for TexPtr, RndTex*
+            // fn_805FBDAC - AtFrame for TexPtr, RndTex*
+            GetTexKeys().AtFrame(f1, tex, mTexCursor);
             mMat->SetDiffuseTex(tex);
         }
         Hmx::Color col(mMat->GetColor());
         if (!ColorKeys().empty()) {
-            ColorKeys().AtFrame(f1, col);
+            ColorKeys().AtFrame(f1, col, mColorCursor);
             if (f2 != 1.0f) {
                 Interp(mMat->GetColor(), col, f2, col);
             }
@@ -211,9 +215,9 @@ void RndMatAnim::SetFrame(float f1, float f2) {
         }
         if (!AlphaKeys().empty()) {
             float alpha = mMat->Alpha();
-            AlphaKeys().AtFrame(f1, alpha); // fn_803B1308 - Keys<float, float>::AtFrame,
-                                            // which calls another AtFrame method
-                                            // fn_803B1374
+            // fn_803B1308 - Keys<float, float>::AtFrame, which calls another
+            // AtFrame method fn_803B1374
+            AlphaKeys().AtFrame(f1, alpha, mAlphaCursor);
             if (f2 != 1.0f) {
                 Interp(mMat->Alpha(), alpha, f2, alpha);
             }
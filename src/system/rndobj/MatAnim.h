@@ -81,6 +81,14 @@ public:
     Keys<Vector3, Vector3> mRotKeys; // 0x48
     /** The collection of texture keys. */
     TexKeys mTexKeys; // 0x50
+    /** Where this anim's last SetFrame landed in each of the keys, which may be
+     * mKeysOwner's, for the next search to start from. */
+    int mTransCursor; // 0x5c
+    int mRotCursor; // 0x60
+    int mScaleCursor; // 0x64
+    int mTexCursor; // 0x68
+    int mColorCursor; // 0x6c
+    int mAlphaCursor; // 0x70
 };
 
 void Interp(const RndMatAnim::TexPtr &, const RndMatAnim::TexPtr &, float, RndTex *&);
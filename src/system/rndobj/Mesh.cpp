@@ -3,7 +3,10 @@
 #include "math/Bsp.h"
 #include "math/Geo.h"
 #include "math/Mtx.h"
+#include "math/Rand.h"
 #include "math/Vec.h"
+#include "math/VecStream.h"
+#include "math/Utl.h"
 #include "math/strips/Striper.h"
 #include "obj/Data.h"
 #include "obj/ObjMacros.h"
@@ -12,6 +15,7 @@
 #include "obj/DataUtl.h"
 #include "os/Debug.h"
 #include "os/System.h"
+#include "os/Timer.h"
 #include "rndobj/Draw.h"
 #include "rndobj/Env.h"
 #include "rndobj/MultiMesh.h"
@@ -24,6 +28,7 @@
 #include "utl/MemMgr.h"
 #include "utl/Std.h"
 #include "utl/Symbols.h"
+#include <list>
 #include <vector>
 
 INIT_REVS(RndMesh)
@@ -41,6 +46,62 @@ DECOMP_FORCEACTIVE(
 
 int RndMesh::MaxBones() { return MAX_BONES; }
 
+bool RndMesh::sCollideBVH = true;
+
+namespace {
+    // last mRevision handed out
+    int gMeshRevision;
+
+    // meshes with fewer faces than this just test them all
+    const int kMinBVHFaces = 16;
+
+    // most bytes of collision BVHs kept around at once
+    const int kMaxBVHBytes = 256 * 1024;
+
+    // geometry owners holding a BVH, and how many bytes those take
+    std::list<RndMesh *> gBVHMeshes;
+    int gBVHBytes;
+    int gBVHUses;
+
+    // tests one face against a segment the way CollideShowing always has, pulling
+    // the segment in to each hit so only nearer faces can hit after it
+    struct FaceCollider {
+        FaceCollider(RndMesh *mesh, float &f, Plane &pl)
+            : mMesh(mesh), mSkin(mesh->IsSkinned() && !RndMesh::sRawCollide), mF(f),
+              mPlane(pl), mHit(false) {}
+
+        void operator()(int face, Segment &seg) {
+            const RndMesh::Face &it = mMesh->Faces(face);
+            const RndMesh::Vert &vert0 = mMesh->Verts(it.v1);
+            const RndMesh::Vert &vert1 = mMesh->Verts(it.v2);
+            const RndMesh::Vert &vert2 = mMesh->Verts(it.v3);
+            Triangle tri;
+            if (mSkin) {
+                tri.Set(
+                    mMesh->SkinVertex(vert0, nullptr),
+                    mMesh->SkinVertex(vert1, nullptr),
+                    mMesh->SkinVertex(vert2, nullptr)
+                );
+            } else
+                tri.Set(vert0.pos, vert1.pos, vert2.pos);
+            float fintersect;
+            if (Intersect(seg, tri, false, fintersect)) {
+                Interp(seg.start, seg.end, fintersect, seg.end);
+                mF *= fintersect;
+                mPlane.Set(tri.origin, tri.frame.z);
+                mHit = true;
+                RndMesh::sLastCollide = face;
+            }
+        }
+
+        RndMesh *mMesh;
+        bool mSkin;
+        float &mF;
+        Plane &mPlane;
+        bool mHit;
+    };
+}
+
 RndDrawable *RndMesh::CollideShowing(const Segment &seg, float &f, Plane &pl) {
     Segment sega0;
     Transform tf58;
@@ -59,31 +120,18 @@ RndDrawable *RndMesh::CollideShowing(const Segment &seg, float &f, Plane &pl) {
         }
     } else {
         if (GetVolume() == kVolumeTriangles) {
-            bool b1 = false;
             f = 1.0f;
-            FOREACH (it, Faces()) {
-                const Vert &vert0 = Verts(it->v1);
-                const Vert &vert1 = Verts(it->v2);
-                const Vert &vert2 = Verts(it->v3);
-                Triangle tri;
-                if (IsSkinned() && !sRawCollide) {
-                    tri.Set(
-                        SkinVertex(vert0, nullptr),
-                        SkinVertex(vert1, nullptr),
-                        SkinVertex(vert2, nullptr)
-                    );
-                } else
-                    tri.Set(vert0.pos, vert1.pos, vert2.pos);
-                float fintersect;
-                if (Intersect(sega0, tri, false, fintersect)) {
-                    Interp(sega0.start, sega0.end, fintersect, sega0.end);
-                    f *= fintersect;
-                    pl.Set(tri.origin, tri.frame.z);
-                    b1 = true;
-                    sLastCollide = (it - Faces().begin());
+            FaceCollider collider(this, f, pl);
+            // skinned faces move with the bones, so only raw ones can use the BVH
+            TriBVH *bvh = collider.mSkin ? nullptr : CollideBVH();
+            if (bvh)
+                bvh->Walk(sega0, collider);
+            else {
+                for (int i = 0; i < Faces().size(); i++) {
+                    collider(i, sega0);
                 }
             }
-            if (b1) {
+            if (collider.mHit) {
                 if (!sRawCollide)
                     Multiply(pl, WorldXfm(), pl);
                 return this;
@@ -93,6 +141,55 @@ RndDrawable *RndMesh::CollideShowing(const Segment &seg, float &f, Plane &pl) {
     return 0;
 }
 
+TriBVH *RndMesh::CollideBVH() {
+    if (mGeomOwner != this)
+        return mGeomOwner->CollideBVH();
+    if (!sCollideBVH || mFaces.size() < kMinBVHFaces)
+        return nullptr;
+    if (mBVH && !mBVH->mDirty) {
+        mBVH->mLastUsed = ++gBVHUses;
+        return mBVH;
+    }
+    std::vector<Box> faceBoxes(mFaces.size());
+    for (int i = 0; i < mFaces.size(); i++) {
+        const Face &face = mFaces[i];
+        Box &box = faceBoxes[i];
+        box.GrowToContain(mVerts[face.v1].pos, true);
+        box.GrowToContain(mVerts[face.v2].pos, false);
+        box.GrowToContain(mVerts[face.v3].pos, false);
+    }
+    if (mBVH) {
+        gBVHBytes -= mBVH->Bytes();
+        mBVH->Refit(faceBoxes);
+    } else {
+        mBVH = new TriBVH();
+        mBVH->Build(faceBoxes);
+        gBVHMeshes.push_back(this);
+    }
+    mBVH->mLastUsed = ++gBVHUses;
+    gBVHBytes += mBVH->Bytes();
+    // make room by freeing whichever BVHs went unused the longest
+    while (gBVHBytes > kMaxBVHBytes && gBVHMeshes.size() > 1) {
+        RndMesh *oldest = nullptr;
+        FOREACH (it, gBVHMeshes) {
+            if (*it == this)
+                continue;
+            if (!oldest || (*it)->mBVH->mLastUsed < oldest->mBVH->mLastUsed)
+                oldest = *it;
+        }
+        oldest->ReleaseBVH();
+    }
+    return mBVH;
+}
+
+void RndMesh::ReleaseBVH() {
+    if (mBVH) {
+        gBVHBytes -= mBVH->Bytes();
+        gBVHMeshes.remove(this);
+        RELEASE(mBVH);
+    }
+}
+
 int RndMesh::CollidePlane(const RndMesh::Face &face, const Plane &plane) {
     bool first = Verts(face.v1).pos <= plane;
     bool second = Verts(face.v2).pos <= plane;
@@ -199,6 +296,7 @@ void RndMesh::SetVolume(RndMesh::Volume vol) {
     else {
         mVolume = vol;
         RELEASE(mBSPTree);
+        ReleaseBVH();
         if (mVerts.empty() || mFaces.empty())
             return;
         else {
@@ -285,16 +383,18 @@ void RndMesh::SetBone(int idx, RndTransformable *bone, bool calcOffset) {
 RndMesh::RndMesh()
     : mMat(this), mGeomOwner(this, this), mBones(this), mMutable(0),
       mVolume(kVolumeTriangles), mBSPTree(0), mMultiMesh(0), mCompressedVerts(0),
-      mNumCompressedVerts(0), mFileLoader(0) {
+      mNumCompressedVerts(0), mFileLoader(0), mBVH(0) {
     mHasAOCalc = false;
     mKeepMeshData = false;
     mUseCachedBoxLightColors = true;
     mForceNoQuantize = false;
+    mRevision = ++gMeshRevision;
 }
 
 RndMesh::~RndMesh() {
     RELEASE(mFileLoader);
     RELEASE(mBSPTree);
+    ReleaseBVH();
     RELEASE(mMultiMesh);
     ClearCompressedVerts();
 }
@@ -939,7 +1039,19 @@ void FaceCenter(RndMesh *mesh, RndMesh::Face *face, Vector3 &v) {
     v *= 0.33333333f;
 }
 
-void RndMesh::Sync(int flags) { OnSync(mKeepMeshData ? flags | 0x200 : flags); }
+void RndMesh::Sync(int flags) {
+    // new faces need a new BVH, moved verts only new boxes
+    RndMesh *owner = mGeomOwner;
+    if (flags & 0x3F)
+        owner->mRevision = ++gMeshRevision;
+    if (owner->mBVH) {
+        if (flags & 0x20)
+            owner->ReleaseBVH();
+        else if (flags & 0x1F)
+            owner->mBVH->mDirty = true;
+    }
+    OnSync(mKeepMeshData ? flags | 0x200 : flags);
+}
 
 void RndMesh::OnSync(int flags) {
     if (mGeomOwner != this || (flags & 0x80U) || !(flags & 0x20U))
@@ -1051,6 +1163,344 @@ Vector3 RndMesh::SkinVertex(const RndMesh::Vert &vert, Vector3 *vptr) {
     return ret;
 }
 
+namespace {
+    // a bone's skinning transform as a unit dual quaternion; Hamilton quats
+    // acting on column vectors, whatever math/Rot.h does
+    struct SkinDualQuat {
+        Hmx::Quat mReal;
+        Hmx::Quat mDual;
+    };
+
+    void MakeSkinDualQuat(const Transform &xfm, SkinDualQuat &dq) {
+        Hmx::Matrix3 m;
+        Normalize(xfm.m, m);
+        // the rows of m are where x, y and z go, so m is R transposed
+        Hmx::Quat &r = dq.mReal;
+        float trace = m.x.x + m.y.y + m.z.z;
+        if (trace > 0) {
+            float s = std::sqrt(trace + 1) * 2;
+            r.Set((m.y.z - m.z.y) / s, (m.z.x - m.x.z) / s, (m.x.y - m.y.x) / s, s / 4);
+        } else if (m.x.x > m.y.y && m.x.x > m.z.z) {
+            float s = std::sqrt(1 + m.x.x - m.y.y - m.z.z) * 2;
+            r.Set(s / 4, (m.y.x + m.x.y) / s, (m.z.x + m.x.z) / s, (m.y.z - m.z.y) / s);
+        } else if (m.y.y > m.z.z) {
+            float s = std::sqrt(1 + m.y.y - m.x.x - m.z.z) * 2;
+            r.Set((m.y.x + m.x.y) / s, s / 4, (m.z.y + m.y.z) / s, (m.z.x - m.x.z) / s);
+        } else {
+            float s = std::sqrt(1 + m.z.z - m.x.x - m.y.y) * 2;
+            r.Set((m.z.x + m.x.z) / s, (m.z.y + m.y.z) / s, s / 4, (m.x.y - m.y.x) / s);
+        }
+        // dual = translation * real / 2
+        const Vector3 &t = xfm.v;
+        Vector3 rv(r.x, r.y, r.z);
+        Vector3 cross;
+        Cross(t, rv, cross);
+        dq.mDual.Set(
+            (r.w * t.x + cross.x) * 0.5f,
+            (r.w * t.y + cross.y) * 0.5f,
+            (r.w * t.z + cross.z) * 0.5f,
+            -Dot(t, rv) * 0.5f
+        );
+    }
+
+    float QuatDot(const Hmx::Quat &a, const Hmx::Quat &b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    }
+
+    void RotateByQuat(const Hmx::Quat &q, const Vector3 &v, Vector3 &out) {
+        Vector3 qv(q.x, q.y, q.z);
+        Vector3 t;
+        Cross(qv, v, t);
+        t *= 2;
+        Vector3 qt;
+        Cross(qv, t, qt);
+        out.Set(v.x + q.w * t.x + qt.x, v.y + q.w * t.y + qt.y, v.z + q.w * t.z + qt.z);
+    }
+
+    // SkinVerts' per bone scratch, kept between calls so skinning doesn't
+    // allocate once they've grown to the biggest mesh's bone count
+    std::vector<Transform> gSkinXfms;
+    std::vector<SkinDualQuat> gSkinDualQuats;
+    std::vector<bool> gSkinValid;
+
+    // a dual quat's translation, 2 * dual * conj(real)
+    void SkinDualQuatPos(const SkinDualQuat &dq, Vector3 &out) {
+        const Hmx::Quat &r = dq.mReal;
+        const Hmx::Quat &d = dq.mDual;
+        Vector3 rv(r.x, r.y, r.z);
+        Vector3 dv(d.x, d.y, d.z);
+        Vector3 cross;
+        Cross(rv, dv, cross);
+        out.Set(
+            (r.w * d.x - d.w * r.x + cross.x) * 2,
+            (r.w * d.y - d.w * r.y + cross.y) * 2,
+            (r.w * d.z - d.w * r.z + cross.z) * 2
+        );
+    }
+}
+
+void RndMesh::SkinVerts(int first, int num, Vector3 *pos, Vector3 *norm, SkinMode mode) {
+    if (first < 0 || first + num > Verts().size()) {
+        MILO_FAIL(
+            "%s: skinning verts %d to %d of %d",
+            PathName(this),
+            first,
+            first + num,
+            Verts().size()
+        );
+    }
+    if (NumBones() == 0) {
+        const Transform &worldXfm = WorldXfm();
+        for (int i = 0; i < num; i++) {
+            const Vert &vert = Verts(first + i);
+            Multiply(vert.pos, worldXfm, pos[i]);
+            if (norm)
+                norm[i] = TransformNormal(vert.norm, worldXfm.m);
+        }
+        return;
+    }
+    int numBones = NumBones();
+    std::vector<Transform> &xfms = gSkinXfms;
+    std::vector<SkinDualQuat> &dqs = gSkinDualQuats;
+    std::vector<bool> &valid = gSkinValid;
+    xfms.resize(numBones);
+    if (mode == kSkinDualQuat)
+        dqs.resize(numBones);
+    valid.resize(numBones);
+    for (int i = 0; i < numBones; i++) {
+        RndTransformable *bone = BoneTransAt(i);
+        valid[i] = bone != nullptr;
+        if (bone) {
+            Multiply(BoneOffsetAt(i), bone->WorldXfm(), xfms[i]);
+            if (mode == kSkinDualQuat)
+                MakeSkinDualQuat(xfms[i], dqs[i]);
+        }
+    }
+    bool warned = false;
+    for (int i = 0; i < num; i++) {
+        const Vert &vert = Verts(first + i);
+        Transform xfm;
+        xfm.Zero();
+        SkinDualQuat dq;
+        dq.mReal.Zero();
+        dq.mDual.Zero();
+        const Hmx::Quat *pivot = nullptr;
+        bool skinned = false;
+        for (int j = 0; j < 4; j++) {
+            int boneIdx = vert.boneIndices[j];
+            if (boneIdx >= numBones || !valid[boneIdx] || !vert.boneWeights[j])
+                continue;
+            float weight = vert.boneWeights.FloatAt(j);
+            if (mode == kSkinDualQuat) {
+                const SkinDualQuat &bone = dqs[boneIdx];
+                // keep every bone in the first one's hemisphere
+                if (!pivot)
+                    pivot = &bone.mReal;
+                else if (QuatDot(*pivot, bone.mReal) < 0)
+                    weight = -weight;
+                StreamLerp(&dq.mReal.x, &bone.mReal.x, 4, 1, weight);
+                StreamLerp(&dq.mDual.x, &bone.mDual.x, 4, 1, weight);
+            } else {
+                StreamLerp(&xfm.m.x.x, &xfms[boneIdx].m.x.x, 12, 1, weight);
+            }
+            skinned = true;
+        }
+        if (!skinned) {
+            if (!warned) {
+                MILO_WARN(
+                    "This mesh (%s // %s) cannot be skinned properly because it has an invalid, unweighted transform",
+                    Name(),
+                    Dir()->GetPathName()
+                );
+                warned = true;
+            }
+            pos[i] = vert.pos;
+            if (norm)
+                norm[i] = vert.norm;
+        } else if (mode == kSkinDualQuat) {
+            float len = std::sqrt(QuatDot(dq.mReal, dq.mReal));
+            StreamScale(&dq.mReal.x, 4, 1 / len);
+            StreamScale(&dq.mDual.x, 4, 1 / len);
+            Vector3 trans;
+            SkinDualQuatPos(dq, trans);
+            RotateByQuat(dq.mReal, vert.pos, pos[i]);
+            pos[i] += trans;
+            if (norm)
+                RotateByQuat(dq.mReal, vert.norm, norm[i]);
+        } else {
+            Multiply(vert.pos, xfm, pos[i]);
+            if (norm)
+                norm[i] = TransformNormal(vert.norm, xfm.m);
+        }
+    }
+}
+
+#ifdef MILO_DEBUG
+// (test_mesh_skinning dir reps) - skins every skinned mesh under dir with
+// SkinVertex and both SkinVerts modes, reports how far SkinVerts strays from
+// SkinVertex and how many verts a second each manages
+static DataNode OnTestMeshSkinning(DataArray *a) {
+    ObjectDir *dir = a->Obj<ObjectDir>(1);
+    int reps = a->Size() > 2 ? a->Int(2) : 10;
+    Timer timers[3];
+    float maxLinearErr = 0;
+    float maxRigidErr = 0;
+    int numVerts = 0;
+    std::vector<Vector3> golden;
+    std::vector<Vector3> goldenNorms;
+    std::vector<Vector3> pos;
+    std::vector<Vector3> norms;
+    for (ObjDirItr<RndMesh> it(dir, true); it != nullptr; ++it) {
+        int n = it->Verts().size();
+        if (!it->IsSkinned() || n == 0)
+            continue;
+        golden.resize(n);
+        goldenNorms.resize(n);
+        pos.resize(n);
+        norms.resize(n);
+        timers[0].Start();
+        for (int r = 0; r < reps; r++) {
+            for (int i = 0; i < n; i++) {
+                golden[i] = it->SkinVertex(it->Verts(i), &goldenNorms[i]);
+            }
+        }
+        timers[0].Stop();
+        timers[1].Start();
+        for (int r = 0; r < reps; r++) {
+            it->SkinVerts(0, n, &pos[0], &norms[0], RndMesh::kSkinLinear);
+        }
+        timers[1].Stop();
+        for (int i = 0; i < n; i++) {
+            MaxEq(maxLinearErr, Distance(golden[i], pos[i]));
+            MaxEq(maxLinearErr, Distance(goldenNorms[i], norms[i]));
+        }
+        timers[2].Start();
+        for (int r = 0; r < reps; r++) {
+            it->SkinVerts(0, n, &pos[0], &norms[0], RndMesh::kSkinDualQuat);
+        }
+        timers[2].Stop();
+        // dual quats only agree with linear blending on verts one bone moves
+        for (int i = 0; i < n; i++) {
+            const Vector4_16_01 &weights = it->Verts(i).boneWeights;
+            if (weights.FloatAt(0) == 1)
+                MaxEq(maxRigidErr, Distance(golden[i], pos[i]));
+        }
+        numVerts += n * reps;
+    }
+    const char *names[3] = { "SkinVertex", "SkinVerts linear", "SkinVerts dual quat" };
+    for (int i = 0; i < 3; i++) {
+        MILO_LOG(
+            "test_mesh_skinning: %s, %.0f verts/s\n",
+            names[i],
+            timers[i].Ms() > 0 ? numVerts * 1000.0f / timers[i].Ms() : 0.0f
+        );
+    }
+    MILO_LOG(
+        "test_mesh_skinning: %d verts, linear max error %g, dual quat max error on rigid verts %g\n",
+        numVerts / Max(reps, 1),
+        maxLinearErr,
+        maxRigidErr
+    );
+    return maxLinearErr < 0.001f;
+}
+#endif
+
+#ifdef MILO_DEBUG
+static Vector3 RandomDir() {
+    Vector3 dir(RandomFloat(-1, 1), RandomFloat(-1, 1), RandomFloat(-1, 1));
+    if (IsFabsZero(Dot(dir, dir)))
+        dir.Set(0, 0, 1);
+    Normalize(dir, dir);
+    return dir;
+}
+
+// (test_mesh_collide dir rays) - fires rays at every rigid triangle mesh under dir
+// with and without its collision BVH, reports any hits that disagree and how
+// many rays a second each manages
+static DataNode OnTestMeshCollide(DataArray *a) {
+    ObjectDir *dir = a->Obj<ObjectDir>(1);
+    int numRays = a->Size() > 2 ? a->Int(2) : 200;
+    bool oldBVH = RndMesh::sCollideBVH;
+    Timer build;
+    Timer timers[2];
+    int mismatches = 0;
+    int hits = 0;
+    int rays = 0;
+    int bvhBytes = 0;
+    std::vector<Segment> segs(numRays);
+    std::vector<float> dists(numRays);
+    std::vector<float> bvhDists(numRays);
+    std::vector<bool> hit(numRays);
+    std::vector<bool> bvhHit(numRays);
+    for (ObjDirItr<RndMesh> it(dir, true); it != nullptr; ++it) {
+        RndMesh *mesh = it;
+        Sphere sphere;
+        if (mesh->IsSkinned() || mesh->GetVolume() != RndMesh::kVolumeTriangles
+            || mesh->GeomOwner()->mBSPTree || !mesh->MakeWorldSphere(sphere, true))
+            continue;
+        RndMesh::sCollideBVH = true;
+        build.Start();
+        TriBVH *bvh = mesh->CollideBVH();
+        build.Stop();
+        if (!bvh)
+            continue;
+        bvhBytes += bvh->Bytes();
+        for (int i = 0; i < numRays; i++) {
+            ScaleAdd(sphere.center, RandomDir(), sphere.radius * 2, segs[i].start);
+            ScaleAdd(sphere.center, RandomDir(), sphere.radius * 0.5f, segs[i].end);
+        }
+        Plane pl;
+        RndMesh::sCollideBVH = false;
+        timers[0].Start();
+        for (int i = 0; i < numRays; i++) {
+            hit[i] = mesh->CollideShowing(segs[i], dists[i], pl) != nullptr;
+        }
+        timers[0].Stop();
+        RndMesh::sCollideBVH = true;
+        timers[1].Start();
+        for (int i = 0; i < numRays; i++) {
+            bvhHit[i] = mesh->CollideShowing(segs[i], bvhDists[i], pl) != nullptr;
+        }
+        timers[1].Stop();
+        for (int i = 0; i < numRays; i++) {
+            // faces tied at the same distance may come back in either order
+            if (bvhHit[i] != hit[i]
+                || (hit[i] && std::fabs(bvhDists[i] - dists[i]) > 0.0001f))
+                mismatches++;
+            if (hit[i])
+                hits++;
+        }
+        rays += numRays;
+    }
+    RndMesh::sCollideBVH = oldBVH;
+    const char *names[2] = { "every face", "BVH" };
+    for (int i = 0; i < 2; i++) {
+        MILO_LOG(
+            "test_mesh_collide: %s, %.0f rays/s\n",
+            names[i],
+            timers[i].Ms() > 0 ? rays * 1000.0f / timers[i].Ms() : 0.0f
+        );
+    }
+    MILO_LOG(
+        "test_mesh_collide: %d rays, %d hits, %d mismatches, BVHs %d bytes built in %.2f ms\n",
+        rays,
+        hits,
+        mismatches,
+        bvhBytes,
+        build.Ms()
+    );
+    return mismatches == 0;
+}
+#endif
+
+void RndMesh::Init() {
+    REGISTER_OBJ_FACTORY(RndMesh)
+#ifdef MILO_DEBUG
+    DataRegisterFunc("test_mesh_skinning", OnTestMeshSkinning);
+    DataRegisterFunc("test_mesh_collide", OnTestMeshCollide);
+#endif
+}
+
 void RndMesh::ClearCompressedVerts() {
     RELEASE(mCompressedVerts);
     mNumCompressedVerts = 0;
@@ -17,6 +17,7 @@
 #define MAX_BONES 40
 
 class RndMultiMesh;
+class TriBVH;
 
 class MotionBlurCache {
 public:
@@ -102,6 +103,12 @@ public:
         kVolumeBox
     };
 
+    /** How SkinVerts blends the bones weighting a vert. */
+    enum SkinMode {
+        kSkinLinear,
+        kSkinDualQuat
+    };
+
     /** A specialized vector for RndMesh vertices. */
     class VertVector { // more custom STL! woohoo!!!! i crave death
     public:
@@ -217,7 +224,23 @@ public:
     void CopyGeometry(const RndMesh *, bool);
     int CollidePlane(const RndMesh::Face &, const Plane &);
     Vector3 SkinVertex(const RndMesh::Vert &, Vector3 *);
+    /** Skin a run of verts the way SkinVertex skins one, working out each bone's
+     * transform once for the whole run rather than once per vert it weights.
+     * @param [in] first The first vert to skin.
+     * @param [in] num How many verts to skin.
+     * @param [out] pos Where to put the num skinned positions.
+     * @param [out] norm Where to put the num skinned normals, or NULL to skip them.
+     * @param [in] mode How to blend the bones; kSkinDualQuat keeps volume at twisting
+     * joints, but ignores any scale in the bones.
+     */
+    void SkinVerts(int first, int num, Vector3 *pos, Vector3 *norm, SkinMode mode);
     void UpdateApproxLighting();
+    /** The geometry owner's collision BVH, built or refit as needed, or NULL if the
+     * mesh is too small to be worth one. Only so many bytes of BVHs are kept, the
+     * least recently used are freed to make room. */
+    TriBVH *CollideBVH();
+    /** Free the collision BVH, if the mesh has one. */
+    void ReleaseBVH();
 
     bool PatchOkay(int i, int j) { return i * 4.31 + j * 0.25 < 329.0; }
 
@@ -232,6 +255,8 @@ public:
     BSPNode *GetBSPTree() const { return mGeomOwner->mBSPTree; }
     RndMat *Mat() const { return mMat; }
     VertVector &Verts() { return mGeomOwner->mVerts; }
+    /** Changes whenever Verts() are synced or loaded, for caches of them. */
+    int Revision() { return mGeomOwner->mRevision; }
     std::vector<Face> &Faces() { return mGeomOwner->mFaces; }
     Vert &Verts(int idx) { return mGeomOwner->mVerts[idx]; }
     Face &Faces(int idx) { return mGeomOwner->mFaces[idx]; }
@@ -247,7 +272,7 @@ public:
     NEW_OBJ(RndMesh)
     NEW_OVERLOAD;
     DELETE_OVERLOAD;
-    static void Init() { REGISTER_OBJ_FACTORY(RndMesh) }
+    static void Init();
 
     DataNode OnCompareEdgeVerts(const DataArray *);
     /** Handler to attach another Mesh's verts/faces to this one.
@@ -329,6 +354,8 @@ public:
     static int MaxBones();
     static int sLastCollide;
     static bool sRawCollide;
+    /** If false, triangle collision tests every face instead of using a BVH. */
+    static bool sCollideBVH;
     static bool sUpdateApproxLight;
     static void SetRawCollide(bool b) { sRawCollide = b; }
     static void SetUpdateApproxLight(bool b) { sUpdateApproxLight = b; }
@@ -356,6 +383,10 @@ public:
     unsigned int mNumCompressedVerts; // 0x118
     FileLoader *mFileLoader; // 0x11c
     GXColor mBoxLightColorsCached[6]; // 0x120
+    /** Bounds on mFaces for kVolumeTriangles collision, made on the first collide. */
+    TriBVH *mBVH; // 0x138
+    /** Changes whenever Sync is told the verts or faces changed, load included. */
+    int mRevision; // 0x13c
 };
 
 BinStream &operator>>(BinStream &, RndMesh::Vert &);
@@ -1,8 +1,13 @@
 #include "rndobj/Morph.h"
+#include "math/Rand.h"
 #include "math/Vec.h"
+#include "math/VecStream.h"
+#include "obj/DataFunc.h"
 #include "obj/ObjMacros.h"
 #include "obj/Object.h"
 #include "os/Debug.h"
+#include "os/System.h"
+#include "os/Timer.h"
 #include "rndobj/Anim.h"
 #include "rndobj/Mesh.h"
 #include "utl/BinStream.h"
@@ -11,8 +16,318 @@
 
 INIT_REVS(RndMorph)
 
+int RndMorphBlender::sMaxIncremental = 64;
+bool RndMorph::sSparse = false;
+
+namespace {
+    // unmoved verts up to this long are kept inside a run rather than splitting it
+    const int kMaxRunGap = 4;
+
+    void PackVerts(RndMesh *mesh, bool norms, std::vector<float> &out) {
+        out.resize(mesh->Verts().size() * 3);
+        float *f = out.empty() ? 0 : &out[0];
+        FOREACH (it, mesh->Verts()) {
+            const Vector3 &v = norms ? it->norm : it->pos;
+            *f++ = v.x;
+            *f++ = v.y;
+            *f++ = v.z;
+        }
+    }
+}
+
+void RndMorphBlender::SetBase(RndMesh *base, bool normals) {
+    mNumVerts = base->Verts().size();
+    mNormals = normals;
+    PackVerts(base, false, mBasePos);
+    if (mNormals)
+        PackVerts(base, true, mBaseNorm);
+    else
+        mBaseNorm.clear();
+    mBlendPos = mBasePos;
+    mBlendNorm = mBaseNorm;
+    mTargets.clear();
+    mIncremental = 0;
+    mMeshes.assign(1, base);
+    mRevisions.assign(1, base->Revision());
+}
+
+void RndMorphBlender::AddTarget(RndMesh *mesh) {
+    if (mesh->Verts().size() != mNumVerts) {
+        MILO_FAIL(
+            "%s has %d verts, the base has %d",
+            PathName(mesh),
+            mesh->Verts().size(),
+            mNumVerts
+        );
+    }
+    mMeshes.push_back(mesh);
+    mRevisions.push_back(mesh->Revision());
+    mTargets.push_back(Target());
+    Target &t = mTargets.back();
+    t.mWeight = 0;
+    t.mApplied = 0;
+    int runEnd = -1;
+    for (int i = 0; i < mNumVerts; i++) {
+        const RndMesh::Vert &v = mesh->Verts()[i];
+        const float *pos = &mBasePos[i * 3];
+        const float *norm = mNormals ? &mBaseNorm[i * 3] : 0;
+        bool moves = v.pos.x != pos[0] || v.pos.y != pos[1] || v.pos.z != pos[2];
+        if (norm && !moves)
+            moves = v.norm.x != norm[0] || v.norm.y != norm[1] || v.norm.z != norm[2];
+        if (!moves)
+            continue;
+        if (runEnd < 0 || i - runEnd > kMaxRunGap) {
+            t.mRuns.push_back(i);
+            t.mRuns.push_back(0);
+            runEnd = i;
+        }
+        // the gap verts have zero offsets, so adding them changes nothing
+        for (; runEnd <= i; runEnd++) {
+            const RndMesh::Vert &gv = mesh->Verts()[runEnd];
+            const float *gp = &mBasePos[runEnd * 3];
+            t.mPos.push_back(gv.pos.x - gp[0]);
+            t.mPos.push_back(gv.pos.y - gp[1]);
+            t.mPos.push_back(gv.pos.z - gp[2]);
+            if (mNormals) {
+                const float *gn = &mBaseNorm[runEnd * 3];
+                t.mNorm.push_back(gv.norm.x - gn[0]);
+                t.mNorm.push_back(gv.norm.y - gn[1]);
+                t.mNorm.push_back(gv.norm.z - gn[2]);
+            }
+        }
+        t.mRuns.back() = runEnd - t.mRuns[t.mRuns.size() - 2];
+    }
+}
+
+// mBlendPos += t's offsets * weight, run by run
+static void
+ScaleAddTarget(RndMorphBlender &b, const RndMorphBlender::Target &t, float w) {
+    const float *pos = t.mPos.empty() ? 0 : &t.mPos[0];
+    const float *norm = t.mNorm.empty() ? 0 : &t.mNorm[0];
+    for (int i = 0; i < t.mRuns.size(); i += 2) {
+        int n = t.mRuns[i + 1] * 3;
+        StreamLerp(&b.mBlendPos[t.mRuns[i] * 3], pos, n, 1, w);
+        pos += n;
+        if (norm) {
+            StreamLerp(&b.mBlendNorm[t.mRuns[i] * 3], norm, n, 1, w);
+            norm += n;
+        }
+    }
+}
+
+void RndMorphBlender::Evaluate() {
+    if (++mIncremental > sMaxIncremental) {
+        Reevaluate();
+        return;
+    }
+    FOREACH (it, mTargets) {
+        if (it->mWeight != it->mApplied) {
+            ScaleAddTarget(*this, *it, it->mWeight - it->mApplied);
+            it->mApplied = it->mWeight;
+        }
+    }
+}
+
+void RndMorphBlender::Reevaluate() {
+    mBlendPos = mBasePos;
+    mBlendNorm = mBaseNorm;
+    FOREACH (it, mTargets) {
+        if (it->mWeight != 0)
+            ScaleAddTarget(*this, *it, it->mWeight);
+        it->mApplied = it->mWeight;
+    }
+    mIncremental = 0;
+}
+
+void RndMorphBlender::Apply(RndMesh *dst, float blend) const {
+    if (dst->Verts().size() != mNumVerts) {
+        MILO_FAIL(
+            "%s has %d verts, the blend has %d",
+            PathName(dst),
+            dst->Verts().size(),
+            mNumVerts
+        );
+    }
+    if (mNumVerts == 0)
+        return;
+    const float *pos = &mBlendPos[0];
+    const float *norm = mNormals ? &mBlendNorm[0] : 0;
+    float keep = 1 - blend;
+    RndMesh::Vert *v = dst->Verts().begin();
+    for (int i = 0; i < mNumVerts; i++, v++, pos += 3) {
+        if (blend == 1)
+            v->pos.Set(pos[0], pos[1], pos[2]);
+        else {
+            v->pos *= keep;
+            ScaleAddEq(v->pos, Vector3(pos[0], pos[1], pos[2]), blend);
+        }
+        if (norm) {
+            if (blend == 1)
+                v->norm.Set(norm[0], norm[1], norm[2]);
+            else {
+                v->norm *= keep;
+                ScaleAddEq(v->norm, Vector3(norm[0], norm[1], norm[2]), blend);
+            }
+            Normalize(v->norm, v->norm);
+            norm += 3;
+        }
+    }
+}
+
+bool RndMorphBlender::Current(const std::vector<RndMesh *> &meshes, bool normals) const {
+    if (meshes != mMeshes || normals != mNormals)
+        return false;
+    for (int i = 0; i < mMeshes.size(); i++) {
+        if (mRevisions[i] != mMeshes[i]->Revision())
+            return false;
+    }
+    return true;
+}
+
+int RndMorphBlender::NumDeltaVerts() const {
+    int num = 0;
+    FOREACH (it, mTargets) {
+        num += it->mPos.size() / 3;
+    }
+    return num;
+}
+
+#ifdef MILO_DEBUG
+namespace {
+    float MaxVertDiff(RndMesh *m1, RndMesh *m2) {
+        float diff = 0;
+        for (int i = 0; i < m1->Verts().size(); i++) {
+            MaxEq(diff, Distance(m1->Verts()[i].pos, m2->Verts()[i].pos));
+        }
+        return diff;
+    }
+
+    // (bench_morph verts poses frames moved) - drags one pose weight per frame,
+    // like a creator slider, through a morph whose poses each move that
+    // fraction of the verts, per vert and then through the sparse blender, then
+    // checks that a synced edit to a pose reaches the sparse blend
+    DataNode BenchMorph(DataArray *a) {
+        int numVerts = a->Size() > 1 ? a->Int(1) : 4000;
+        int numPoses = a->Size() > 2 ? a->Int(2) : 32;
+        int frames = a->Size() > 3 ? a->Int(3) : 60;
+        float moved = a->Size() > 4 ? a->Float(4) : 0.1f;
+        if (numPoses < 2 || numVerts < 1)
+            return 0;
+        RndMorph *morph = Hmx::Object::New<RndMorph>();
+        RndMesh *targets[2];
+        for (int i = 0; i < 2; i++) {
+            targets[i] = Hmx::Object::New<RndMesh>();
+            targets[i]->Verts().resize(numVerts, true);
+        }
+        morph->SetNumPoses(numPoses);
+        for (int i = 0; i < numPoses; i++) {
+            RndMesh *mesh = Hmx::Object::New<RndMesh>();
+            mesh->Verts().resize(numVerts, true);
+            // each pose moves one contiguous patch, as face shapes do
+            int first = RandomInt(0, numVerts);
+            for (int j = 0; j < numVerts; j++) {
+                Vector3 &pos = mesh->Verts()[j].pos;
+                pos.Set(j, j * 0.5f, 0);
+                if (i > 0 && (j - first + numVerts) % numVerts < numVerts * moved)
+                    pos.z = RandomFloat(-1, 1);
+            }
+            morph->PoseAt(i).mesh = mesh;
+            morph->PoseAt(i).weights.Add(0, 0, false);
+        }
+        std::vector<float> weights(frames);
+        for (int f = 0; f < frames; f++) {
+            weights[f] = RandomFloat(0, 1.0f / numPoses);
+        }
+        // the per vert pass frees the blender, so each pass drags through every
+        // frame before the other starts
+        bool oldSparse = RndMorph::sSparse;
+        Timer timers[2];
+        for (int pass = 0; pass < 2; pass++) {
+            RndMorph::sSparse = pass == 1;
+            morph->SetTarget(targets[pass]);
+            for (int i = 1; i < numPoses; i++) {
+                morph->PoseAt(i).weights.front().value = 0;
+            }
+            for (int f = 0; f < frames; f++) {
+                morph->PoseAt(1 + f % (numPoses - 1)).weights.front().value = weights[f];
+                timers[pass].Start();
+                morph->SetFrame(0, 1);
+                timers[pass].Stop();
+            }
+        }
+        float maxDiff = MaxVertDiff(targets[0], targets[1]);
+        int deltaVerts = morph->mBlender ? morph->mBlender->NumDeltaVerts() : 0;
+        // an edit to a pose in place has to reach the sparse blend once synced
+        RndMesh *edited = morph->PoseAt(1).mesh;
+        edited->Verts()[0].pos.z += 1;
+        edited->Sync(0x1F);
+        morph->PoseAt(1).weights.front().value = 1;
+        for (int pass = 1; pass >= 0; pass--) {
+            RndMorph::sSparse = pass == 1;
+            morph->SetTarget(targets[pass]);
+            morph->SetFrame(0, 1);
+        }
+        MaxEq(maxDiff, MaxVertDiff(targets[0], targets[1]));
+        RndMorph::sSparse = oldSparse;
+        MILO_LOG(
+            "bench_morph: %d verts, %d poses, %d delta verts, per vert %.3f ms, sparse %.3f ms per drag, max diff %g\n",
+            numVerts,
+            numPoses,
+            deltaVerts,
+            frames > 0 ? timers[0].Ms() / frames : 0.0f,
+            frames > 0 ? timers[1].Ms() / frames : 0.0f,
+            maxDiff
+        );
+        for (int i = 0; i < numPoses; i++) {
+            delete morph->PoseAt(i).mesh.Ptr();
+        }
+        delete targets[0];
+        delete targets[1];
+        delete morph;
+        return maxDiff < 0.001f;
+    }
+}
+#endif
+
+void RndMorph::Init() {
+    REGISTER_OBJ_FACTORY(RndMorph)
+    DataArray *cfg = SystemConfig("objects")->FindArray("RndMorph", false);
+    if (cfg)
+        cfg->FindData("sparse", sSparse, false);
+#ifdef MILO_DEBUG
+    DataRegisterFunc("bench_morph", BenchMorph);
+#endif
+}
+
 RndMorph::RndMorph()
-    : mPoses(this), mTarget(this, 0), mNormals(0), mSpline(0), mIntensity(1.0f) {}
+    : mPoses(this), mTarget(this, 0), mNormals(0), mSpline(0), mIntensity(1.0f),
+      mBlender(0) {}
+
+bool RndMorph::SyncBlender() {
+    int numVerts = mTarget->Verts().size();
+    std::vector<RndMesh *> meshes(mPoses.size());
+    for (int i = 0; i < mPoses.size(); i++) {
+        meshes[i] = mPoses[i].mesh;
+        // the per vert blend skips missing poses and clips to the shortest,
+        // which isn't a blend around the first pose any more
+        if (!meshes[i] || meshes[i]->Verts().size() != numVerts) {
+            InvalidateBlender();
+            return false;
+        }
+    }
+    if (mBlender && mBlender->Current(meshes, mNormals))
+        return true;
+    if (!mBlender)
+        mBlender = new RndMorphBlender();
+    for (int i = 0; i < meshes.size(); i++) {
+        if (i == 0)
+            mBlender->SetBase(meshes[i], mNormals);
+        else
+            mBlender->AddTarget(meshes[i]);
+    }
+    mBlender->Reevaluate();
+    return true;
+}
 
 float RndMorph::InterpWeight(const Keys<float, float> &keys, float frame) {
     const Key<float> *prev;
@@ -37,9 +352,21 @@ float RndMorph::InterpWeight(const Keys<float, float> &keys, float frame) {
 // retail scratch: https://decomp.me/scratch/UVC1l
 void RndMorph::SetFrame(float frame, float blend) {
     RndAnimatable::SetFrame(frame, blend);
+    if (!sSparse)
+        InvalidateBlender();
     if (!mTarget || mPoses.empty())
         return;
-    else {
+    else if (sSparse && SyncBlender()) {
+        // the first pose takes whatever weight the others leave, so the blend is
+        // the first pose plus each other's offset from it at its own weight
+        for (int i = 1; i < mPoses.size(); i++) {
+            float weight = mIntensity * InterpWeight(mPoses[i].weights, frame);
+            mBlender->SetWeight(i - 1, weight);
+        }
+        mBlender->Evaluate();
+        mBlender->Apply(mTarget, blend);
+        mTarget->Sync(0x1F);
+    } else {
         float f1 = 1.0f;
         bool b3 = true;
         RndMesh::Vert *vertEnd = mTarget->Verts().end();
@@ -119,6 +446,7 @@ BEGIN_COPYS(RndMorph)
     COPY_MEMBER_FROM(f, mNormals)
     COPY_MEMBER_FROM(f, mSpline)
     COPY_MEMBER_FROM(f, mIntensity)
+    InvalidateBlender();
 END_COPYS
 
 TextStream &operator<<(TextStream &ts, const RndMorph::Pose &pose) {
@@ -169,6 +497,7 @@ BEGIN_LOADS(RndMorph)
     }
     if (gRev > 2)
         bs >> mIntensity;
+    InvalidateBlender();
 END_LOADS
 
 BEGIN_HANDLERS(RndMorph)
@@ -216,6 +545,7 @@ DataNode RndMorph::OnPoseMesh(const DataArray *arr) {
 
 DataNode RndMorph::OnSetPoseMesh(const DataArray *arr) {
     PoseAt(arr->Int(2)).mesh = arr->Obj<RndMesh>(3);
+    InvalidateBlender();
     return 0;
 }
 
@@ -5,6 +5,66 @@
 #include "obj/ObjVector.h"
 #include "rndobj/Mesh.h"
 #include "math/Key.h"
+#include <vector>
+
+/**
+ * @brief Sparse weighted blend of mesh poses around a base pose.
+ *
+ * Each target keeps only the runs of verts that differ from the base, as packed
+ * offsets. The blend is kept between evaluations, so a weight change only
+ * re-adds the verts its target moves, and targets left at zero cost nothing.
+ */
+class RndMorphBlender {
+public:
+    /** One pose, as its offsets from the base. */
+    struct Target {
+        /** First vert and vert count of each run that moves. */
+        std::vector<int> mRuns; // 0x0
+        /** x, y, z of each moved vert's offset, run after run. */
+        std::vector<float> mPos; // 0xc
+        std::vector<float> mNorm; // 0x18
+        float mWeight; // 0x24
+        /** The weight mBlendPos and mBlendNorm hold this target at. */
+        float mApplied; // 0x28
+    };
+
+    RndMorphBlender() : mNumVerts(0), mIncremental(0), mNormals(false) {}
+
+    /** Whether it was built from meshes, with normals or not, that haven't
+     * changed since. */
+    bool Current(const std::vector<RndMesh *> &meshes, bool normals) const;
+
+    /** Start over with base as the pose at zero weight, and no targets. */
+    void SetBase(RndMesh *base, bool normals);
+    /** Add mesh, which must match the base's vert count, as the next target. */
+    void AddTarget(RndMesh *mesh);
+    void SetWeight(int target, float weight) { mTargets[target].mWeight = weight; }
+    float Weight(int target) const { return mTargets[target].mWeight; }
+    int NumTargets() const { return mTargets.size(); }
+    /** Bring the blend up to date by adding each changed weight's difference. */
+    void Evaluate();
+    /** Rebuild the blend from the base and the targets with nonzero weight. */
+    void Reevaluate();
+    /** dst's verts = dst's verts * (1 - blend) + the blend * blend. */
+    void Apply(RndMesh *dst, float blend) const;
+    /** How many verts the targets store offsets for. */
+    int NumDeltaVerts() const;
+
+    /** Incremental evaluations before Evaluate rebuilds the blend, to bound drift. */
+    static int sMaxIncremental;
+
+    std::vector<float> mBasePos; // 0x0
+    std::vector<float> mBaseNorm; // 0xc
+    std::vector<float> mBlendPos; // 0x18
+    std::vector<float> mBlendNorm; // 0x24
+    std::vector<Target> mTargets; // 0x30
+    int mNumVerts; // 0x3c
+    int mIncremental; // 0x40
+    bool mNormals; // 0x44
+    /** The meshes the base and targets came from, and their Revision() then. */
+    std::vector<RndMesh *> mMeshes; // 0x48
+    std::vector<int> mRevisions; // 0x54
+};
 
 /**
  * @brief A set of RndMesh poses that can be blended between.
@@ -35,18 +95,28 @@ public:
     virtual void Save(BinStream &);
     virtual void Copy(const Hmx::Object *, Hmx::Object::CopyType);
     virtual void Load(BinStream &);
-    virtual ~RndMorph() {}
+    virtual ~RndMorph() { InvalidateBlender(); }
     virtual void SetFrame(float, float);
     virtual float EndFrame();
     virtual void Print();
 
     float InterpWeight(const Keys<float, float> &, float);
 
-    void SetNumPoses(int num) { mPoses.resize(num); }
+    void SetNumPoses(int num) {
+        mPoses.resize(num);
+        InvalidateBlender();
+    }
     int NumPoses() const { return mPoses.size(); }
     Pose &PoseAt(int idx) { return mPoses[idx]; }
     void SetIntensity(float intensity) { mIntensity = intensity; }
     void SetTarget(RndMesh *target) { mTarget = target; }
+    /** Whether SetFrame can blend through mBlender, building it if it's missing or
+     * the poses moved. */
+    bool SyncBlender();
+    /** Free mBlender, so the next sparse SetFrame builds it again, e.g. after pose
+     * verts are edited without a Sync.
+     */
+    void InvalidateBlender() { RELEASE(mBlender); }
 
     DataNode OnSetIntensity(const DataArray *);
     DataNode OnSetTarget(const DataArray *);
@@ -58,7 +128,13 @@ public:
     DELETE_OVERLOAD;
     DECLARE_REVS;
     NEW_OBJ(RndMorph)
-    static void Init() { REGISTER_OBJ_FACTORY(RndMorph) }
+    static void Init();
+
+    /** Blend through mBlender when the poses allow, rather than every vert of each.
+     * Off unless the sparse config under objects/RndMorph is set, since each morph
+     * that blends this way keeps its poses' offsets and the blend around.
+     */
+    static bool sSparse;
 
     /** "[Number of] mesh keyframes to blend" */
     ObjVector<Pose> mPoses; // 0x10
@@ -70,4 +146,7 @@ public:
     bool mSpline; // 0x29
     /** "Modifier for weight interpolation" */
     float mIntensity; // 0x2c
+    /** The first pose is the base, the rest are its targets in order. Only built
+     * while sSparse is on. */
+    RndMorphBlender *mBlender; // 0x30
 };
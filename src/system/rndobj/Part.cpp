@@ -3,6 +3,7 @@
 #include "math/Rand.h"
 #include "math/Rot.h"
 #include "math/Trig.h"
+#include "math/Utl.h"
 #include "obj/Data.h"
 #include "obj/ObjMacros.h"
 #include "obj/Object.h"
@@ -56,12 +57,68 @@ namespace {
     }
 }
 
+#ifdef MILO_DEBUG
+namespace {
+    // a system with numParts live particles that outlive life frames
+    RndParticleSys *NewBenchSystem(int numParts, int life, bool fancy) {
+        RndParticleSys *sys = Hmx::Object::New<RndParticleSys>();
+        sys->SetPool(numParts, fancy ? RndParticleSys::kFancy : RndParticleSys::kBasic);
+        sys->SetLife(life, life);
+        sys->SetSpeed(0.5f, 2);
+        sys->SetStartSize(1, 2);
+        sys->SetDeltaSize(-1, 1);
+        sys->SetStartColor(Hmx::Color(1, 1, 1, 1), Hmx::Color(1, 1, 1, 1));
+        sys->SetEndColor(Hmx::Color(0, 0, 0, 0), Hmx::Color(1, 0, 0, 0));
+        sys->SetForceDir(Vector3(0, 0, -0.01f));
+        sys->SetDrag(0.01f);
+        sys->ExplicitParticles(numParts, true, gNoPartOverride);
+        return sys;
+    }
+
+    // (bench_particles systems particles frames) - steps that many basic and fancy
+    // systems for that many frames and reports how long each frame took
+    DataNode BenchParticles(DataArray *a) {
+        int numSystems = a->Size() > 1 ? a->Int(1) : 16;
+        int numParts = a->Size() > 2 ? a->Int(2) : 100;
+        int frames = a->Size() > 3 ? a->Int(3) : 60;
+        if (!gParticlePool)
+            return 0;
+        std::vector<RndParticleSys *> systems;
+        for (int i = 0; i < numSystems; i++) {
+            systems.push_back(NewBenchSystem(numParts, frames * 2, i & 1));
+        }
+        Timer timer;
+        timer.Start();
+        for (int f = 1; f <= frames; f++) {
+            FOREACH (it, systems) {
+                (*it)->MoveParticles(f, 1);
+            }
+        }
+        timer.Stop();
+        MILO_LOG(
+            "bench_particles: %d systems of %d particles, %.3f ms per frame, high water mark %d\n",
+            numSystems,
+            numParts,
+            frames > 0 ? timer.Ms() / frames : 0.0f,
+            gParticlePool->HighWaterMark()
+        );
+        FOREACH (it, systems) {
+            delete *it;
+        }
+        return 1;
+    }
+}
+#endif
+
 void InitParticleSystem() {
     if (!gParticlePool)
         gParticlePool = new ParticleCommonPool();
     if (gParticlePool)
         gParticlePool->InitPool();
     DataRegisterFunc("print_particle_pool_size", PrintParticlePoolSize);
+#ifdef MILO_DEBUG
+    DataRegisterFunc("bench_particles", BenchParticles);
+#endif
 }
 
 int GetParticleHighWaterMark() {
@@ -991,7 +1048,93 @@ float RndParticleSys::CheckBursts(float f1) {
     return sum;
 }
 
-void RndParticleSys::MoveParticles(float, float) { START_AUTO_TIMER("psysmove"); }
+namespace {
+    // applies force, drag and spin for this step
+    void AccelerateParticle(
+        RndParticle *p,
+        bool fancy,
+        const Vector3 &deltaForce,
+        float drag,
+        float rotDrag,
+        float dt
+    ) {
+        Vector3 &vel = p->Vel3();
+        vel *= drag;
+        vel += deltaForce;
+        if (fancy) {
+            RndFancyParticle *fp = static_cast<RndFancyParticle *>(p);
+            fp->angle += fp->RPF * dt;
+            fp->RPF *= rotDrag;
+            fp->swingArm += fp->swingArmVel * dt;
+        }
+    }
+
+    // how fast a particle's color and size change per frame at frame; fancy
+    // particles grow, hold and shrink, and head for their mid color first
+    void ParticleRates(
+        const RndParticle *p, bool fancy, float frame, Hmx::Color &col, float &size
+    ) {
+        if (!fancy) {
+            col = p->colVel;
+            size = p->sizeVel;
+            return;
+        }
+        const RndFancyParticle *fp = static_cast<const RndFancyParticle *>(p);
+        if (frame < fp->midcolFrame) {
+            Multiply(fp->midcolVel, fp->vel.w, col);
+        } else
+            col = fp->colVel;
+        if (frame < fp->growFrame)
+            size = fp->growVel;
+        else if (frame < fp->shrinkFrame)
+            size = fp->sizeVel;
+        else
+            size = fp->shrinkVel;
+    }
+}
+
+void RndParticleSys::MoveParticles(float frame, float dt) {
+    START_AUTO_TIMER("psysmove");
+    bool fancy = mType == kFancy;
+    // the force is in world space, the particles relative to mRelativeXfm
+    Transform tf;
+    Transpose(mRelativeXfm, tf);
+    Vector3 deltaForce;
+    Multiply(mForceDir, tf.m, deltaForce);
+    deltaForce *= dt;
+    float drag = Max(0.0f, 1.0f - mDrag * dt);
+    float rotDrag = Max(0.0f, 1.0f - mRPMDrag * dt);
+    Hmx::Color colRate;
+    float sizeRate;
+    RndParticle *p = mActiveParticles;
+    while (p) {
+        if (CheckParticleLife(frame, p)) {
+            p = FreeParticle(p);
+            continue;
+        }
+        AccelerateParticle(p, fancy, deltaForce, drag, rotDrag, dt);
+        ParticleRates(p, fancy, frame, colRate, sizeRate);
+        ScaleAddEq(p->Pos3(), p->Vel3(), dt);
+        p->col.red += colRate.red * dt;
+        p->col.green += colRate.green * dt;
+        p->col.blue += colRate.blue * dt;
+        p->col.alpha += colRate.alpha * dt;
+        p->size += sizeRate * dt;
+        p = p->next;
+    }
+}
+
+void RndParticleSys::UpdateParticles() {
+    if (mNeedForward)
+        RunFastForward();
+    float frame = CalcFrame();
+    float dt = Max(0.0f, frame - unke4);
+    Transform tf;
+    MakeLocToRel(tf);
+    MoveParticles(frame, dt);
+    CreateParticles(frame, dt, tf);
+    unke4 = frame;
+}
 
 RndParticleSys::~RndParticleSys() {
     if (mPreserveParticles) {
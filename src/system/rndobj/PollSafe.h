@@ -0,0 +1,19 @@
+#pragma once
+#include "obj/Object.h"
+#include <list>
+
+/**
+ * @brief A pollable whose Poll only touches the objects it declares.
+ * SchedulePolls may move the Poll of anything that also derives from this among
+ * neighbors that touch none of those objects. Kept apart from RndPollable so
+ * its vtable stays as shipped.
+ */
+class RndPollSafe : public virtual Hmx::Object {
+public:
+    RndPollSafe() {}
+    virtual ~RndPollSafe() {}
+    /** List the objects Poll reads and writes. */
+    virtual void ListPollDeps(
+        std::list<Hmx::Object *> &reads, std::list<Hmx::Object *> &writes
+    ) const = 0;
+};
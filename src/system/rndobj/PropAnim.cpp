@@ -1,10 +1,12 @@
 #include "rndobj/PropAnim.h"
 #include "math/Color.h"
 #include "obj/Data.h"
+#include "obj/Dir.h"
 #include "obj/ObjMacros.h"
 #include "obj/Object.h"
 #include "obj/ObjectStage.h"
 #include "os/System.h"
+#include "os/Timer.h"
 #include "rndobj/EventTrigger.h"
 #include "rndobj/PropKeys.h"
 #include "utl/Std.h"
@@ -839,3 +841,91 @@ BEGIN_PROPSYNCS(RndPropAnim)
     SYNC_PROP(loop, mLoop)
     SYNC_SUPERCLASS(RndAnimatable)
 END_PROPSYNCS
+
+#ifdef MILO_DEBUG
+// sets every anim to frames evenly spaced frames, returns the keys evaluated
+static int SweepPropAnims(std::vector<RndPropAnim *> &anims, int frames) {
+    int evals = 0;
+    FOREACH (it, anims) {
+        RndPropAnim *anim = *it;
+        float start = anim->StartFrame();
+        float end = anim->EndFrame();
+        for (int i = 0; i < frames; i++) {
+            anim->SetFrame(start + (end - start) * i / frames, 1.0f);
+        }
+        evals += frames * anim->mPropKeys.size();
+    }
+    return evals;
+}
+
+// rebinds every key of anims with PropKeys::sBindProps set to bind, returns how
+// many ended up on a direct setter
+static int BindPropAnims(std::vector<RndPropAnim *> &anims, bool bind) {
+    PropKeys::sBindProps = bind;
+    int bound = 0;
+    FOREACH (it, anims) {
+        FOREACH (keys, (*it)->mPropKeys) {
+            (*keys)->Bind();
+            if ((*keys)->mBinding != PropKeys::kBindProperty)
+                bound++;
+        }
+    }
+    return bound;
+}
+
+// (bench_prop_anims dir frames) - sweeps every prop anim under dir through
+// SetProperty and then through the bound setters, reports key evaluations a
+// second for each
+static DataNode OnBenchPropAnims(DataArray *a) {
+    ObjectDir *dir = a->Obj<ObjectDir>(1);
+    int frames = a->Size() > 2 ? a->Int(2) : 100;
+    std::vector<RndPropAnim *> anims;
+    std::vector<float> oldFrames;
+    int numKeys = 0;
+    for (ObjDirItr<RndPropAnim> it(dir, true); it != nullptr; ++it) {
+        anims.push_back(it);
+        oldFrames.push_back(it->GetFrame());
+        numKeys += it->mPropKeys.size();
+    }
+    if (anims.empty()) {
+        MILO_LOG("bench_prop_anims: no prop anims under %s\n", dir->Name());
+        return 0;
+    }
+    bool oldBind = PropKeys::sBindProps;
+    Timer timers[2];
+    int evals = 0;
+    int bound = 0;
+    for (int i = 0; i < 2; i++) {
+        bound = BindPropAnims(anims, i == 1);
+        timers[i].Start();
+        evals = SweepPropAnims(anims, frames);
+        timers[i].Stop();
+    }
+    BindPropAnims(anims, oldBind);
+    for (int i = 0; i < anims.size(); i++) {
+        anims[i]->SetFrame(oldFrames[i], 1.0f);
+    }
+    const char *names[2] = { "SetProperty", "bound" };
+    for (int i = 0; i < 2; i++) {
+        MILO_LOG(
+            "bench_prop_anims: %s, %.0f evals/s\n",
+            names[i],
+            timers[i].Ms() > 0 ? evals * 1000.0f / timers[i].Ms() : 0.0f
+        );
+    }
+    MILO_LOG(
+        "bench_prop_anims: %d anims, %d keys, %d bound to direct setters\n",
+        anims.size(),
+        numKeys,
+        bound
+    );
+    return timers[1].Ms() > 0 ? evals * 1000.0f / timers[1].Ms() : 0.0f;
+}
+#endif
+
+void RndPropAnim::Init() {
+    REGISTER_OBJ_FACTORY(RndPropAnim)
+#ifdef MILO_DEBUG
+    DataRegisterFunc("bench_prop_anims", OnBenchPropAnims);
+#endif
+}
@@ -185,7 +185,7 @@ public:
     NEW_OVERLOAD;
     DELETE_OVERLOAD;
     NEW_OBJ(RndPropAnim)
-    static void Init() { REGISTER_OBJ_FACTORY(RndPropAnim) }
+    static void Init();
 
     /** A collection of PropKeys. */
     std::vector<PropKeys *> mPropKeys; // 0x10
@@ -5,10 +5,14 @@
 #include "obj/DataUtl.h"
 #include "math/Rot.h"
 #include "os/System.h"
+#include "rndobj/Draw.h"
+#include "rndobj/Mat.h"
+#include "utl/Symbols.h"
 
 unsigned short PropKeys::gRev = 0;
 Hmx::Object *ObjectStage::sOwner = 0;
 Message PropKeys::sInterpMessage(gNullStr, 0, 0, 0, 0, 0);
+bool PropKeys::sBindProps = true;
 
 void SetPropKeysRev(int rev) { PropKeys::gRev = rev; }
 
@@ -35,7 +39,8 @@ BinStream &operator<<(BinStream &bs, const ObjectStage &stage) {
 PropKeys::PropKeys(Hmx::Object *targetOwner, Hmx::Object *target)
     : mTarget(targetOwner, target), mProp(0), mTrans(0), mInterpHandler(),
       mLastKeyFrameIndex(-2), mKeysType(kFloat), mInterpolation(kLinear),
-      mPropExceptionID(kNoException), unk18lastbit(0) {}
+      mPropExceptionID(kNoException), unk18lastbit(0), mBinding(kBindProperty),
+      mBoundDraw(nullptr) {}
 
 PropKeys::~PropKeys() {
     if (mProp) {
@@ -277,6 +282,7 @@ unsigned int PropKeys::PropExceptionID(Hmx::Object *o, DataArray *arr) {
 }
 
 void PropKeys::SetPropExceptionID() {
+    Bind();
     if (!mInterpHandler.Null())
         mPropExceptionID = kHandleInterp;
     else {
@@ -292,6 +298,60 @@ void PropKeys::SetPropExceptionID() {
     }
 }
 
+PropKeys::BindingID PropKeys::PropBindingID(Hmx::Object *o, DataArray *arr) {
+    if (!o || !arr || arr->Size() != 1 || arr->Type(0) != kDataSymbol)
+        return kBindProperty;
+    Symbol prop = arr->Sym(0);
+    // only paths nothing further down the class overrides in its SyncProperty
+    if (prop == showing && dynamic_cast<RndDrawable *>(o))
+        return kBindShowing;
+    if (dynamic_cast<RndMat *>(o)) {
+        if (prop == alpha)
+            return kBindMatAlpha;
+        if (prop == color)
+            return kBindMatColor;
+    }
+    return kBindProperty;
+}
+
+void PropKeys::Bind() {
+    mBinding = sBindProps ? PropBindingID(mTarget.Ptr(), mProp) : kBindProperty;
+    switch (mBinding) {
+    case kBindShowing:
+        mBoundDraw = dynamic_cast<RndDrawable *>(mTarget.Ptr());
+        break;
+    case kBindMatAlpha:
+    case kBindMatColor:
+        mBoundMat = dynamic_cast<RndMat *>(mTarget.Ptr());
+        break;
+    default:
+        mBoundDraw = nullptr;
+        break;
+    }
+}
+
+void PropKeys::SetBoundProperty(float f) {
+    if (mBinding == kBindMatAlpha)
+        mBoundMat->SetAlpha(f);
+    else
+        mTarget->SetProperty(mProp, f);
+}
+
+void PropKeys::SetBoundProperty(const Hmx::Color &col) {
+    if (mBinding == kBindMatColor) {
+        // through Pack() like the (color) prop, so keyed colors quantize the same
+        mBoundMat->SetColor(Hmx::Color(col.Pack()));
+    } else
+        mTarget->SetProperty(mProp, col.Pack());
+}
+
+void PropKeys::SetBoundProperty(bool b) {
+    if (mBinding == kBindShowing)
+        mBoundDraw->SetShowing(b);
+    else
+        mTarget->SetProperty(mProp, b);
+}
+
 void PropKeys::SetInterpHandler(Symbol sym) {
     mInterpHandler = sym;
     SetPropExceptionID();
@@ -304,7 +364,8 @@ int FloatKeys::FloatAt(float frame, float &fl) {
     float ref = 0.0f;
     const Key<float> *prev;
     const Key<float> *next;
-    int at = AtFrame(frame, prev, next, ref);
+    int cursor = mLastKeyFrameIndex;
+    int at = AtFrame(frame, prev, next, ref, cursor);
     switch (mInterpolation) {
     case kStep:
         fl = prev->value;
@@ -355,7 +416,8 @@ void FloatKeys::SetFrame(float frame, float blend) {
         const Key<float> *prev;
         const Key<float> *next;
         float ref = 0.0f;
-        idx = AtFrame(frame, prev, next, ref);
+        int cursor = mLastKeyFrameIndex;
+        idx = AtFrame(frame, prev, next, ref, cursor);
         sInterpMessage.SetType(mInterpHandler);
         sInterpMessage[0] = prev->value;
         sInterpMessage[1] = next->value;
@@ -369,13 +431,14 @@ void FloatKeys::SetFrame(float frame, float blend) {
     } else {
         float val;
         idx = FloatAt(frame, val);
-        mTarget->SetProperty(mProp, val);
+        SetBoundProperty(val);
     }
     mLastKeyFrameIndex = idx;
 }
 
 int ColorKeys::ColorAt(float frame, Hmx::Color &color) {
     MILO_ASSERT(size(), 0x1E8);
+    int cursor = mLastKeyFrameIndex;
     color.Set(0, 0, 0);
     int at = 0;
     switch (mInterpolation) {
@@ -383,17 +446,17 @@ int ColorKeys::ColorAt(float frame, Hmx::Color &color) {
         const Key<Hmx::Color> *prevstep;
         const Key<Hmx::Color> *nextstep;
         float refstep;
-        at = AtFrame(frame, prevstep, nextstep, refstep);
+        at = AtFrame(frame, prevstep, nextstep, refstep, cursor);
         color = prevstep->value;
         break;
     case kLinear:
-        at = AtFrame(frame, color);
+        at = AtFrame(frame, color, cursor);
         break;
     case kEaseIn:
         const Key<Hmx::Color> *prev5;
         const Key<Hmx::Color> *next5;
         float ref5;
-        AtFrame(frame, prev5, next5, ref5);
+        AtFrame(frame, prev5, next5, ref5, cursor);
         if (prev5)
             Interp(prev5->value, next5->value, ref5 * ref5 * ref5, color);
         break;
@@ -401,7 +464,7 @@ int ColorKeys::ColorAt(float frame, Hmx::Color &color) {
         const Key<Hmx::Color> *prev;
         const Key<Hmx::Color> *next;
         float ref;
-        AtFrame(frame, prev, next, ref);
+        AtFrame(frame, prev, next, ref, cursor);
         ref = 1.0f - ref;
         if (prev)
             Interp(prev->value, next->value, -(ref * ref * ref - 1.0f), color);
@@ -417,13 +480,14 @@ void ColorKeys::SetFrame(float frame, float blend) {
         return;
     Hmx::Color col;
     int idx = ColorAt(frame, col);
-    mTarget->SetProperty(mProp, col.Pack());
+    SetBoundProperty(col);
     mLastKeyFrameIndex = idx;
 }
 
 int ObjectKeys::ObjectAt(float frame, Hmx::Object *&obj) {
     MILO_ASSERT(size(), 0x22A);
-    return AtFrame(frame, obj);
+    int cursor = mLastKeyFrameIndex;
+    return AtFrame(frame, obj, cursor);
 }
 
 void ObjectKeys::SetFrame(float frame, float blend) {
@@ -437,7 +501,8 @@ void ObjectKeys::SetFrame(float frame, float blend) {
         const Key<ObjectStage> *prev;
         const Key<ObjectStage> *next;
         float ref = 0.0f;
-        idx = AtFrame(frame, prev, next, ref);
+        int cursor = mLastKeyFrameIndex;
+        idx = AtFrame(frame, prev, next, ref, cursor);
         sInterpMessage.SetType(mInterpHandler);
         sInterpMessage[0] = prev->value.Ptr();
         sInterpMessage[1] = next->value.Ptr();
@@ -464,7 +529,8 @@ void ObjectKeys::SetFrame(float frame, float blend) {
 
 int BoolKeys::BoolAt(float frame, bool &b) {
     MILO_ASSERT(size(), 0x25C);
-    return AtFrame(frame, b);
+    int cursor = mLastKeyFrameIndex;
+    return AtFrame(frame, b, cursor);
 }
 
 void BoolKeys::SetFrame(float frame, float blend) {
@@ -475,7 +541,7 @@ void BoolKeys::SetFrame(float frame, float blend) {
         bool b;
         idx = BoolAt(frame, b);
         if (mInterpolation != kStep || mLastKeyFrameIndex != idx) {
-            mTarget->SetProperty(mProp, b);
+            SetBoundProperty(b);
         }
     } else if (mPropExceptionID == kHandleInterp) {
         bool b;
@@ -495,7 +561,8 @@ int QuatKeys::QuatAt(float frame, Hmx::Quat &quat) {
     const Key<Hmx::Quat> *prev;
     const Key<Hmx::Quat> *next;
     float ref = 0.0f;
-    int at = AtFrame(frame, prev, next, ref);
+    int cursor = mLastKeyFrameIndex;
+    int at = AtFrame(frame, prev, next, ref, cursor);
     if (mInterpolation == kSpline)
         QuatSpline(*this, prev, next, ref, quat);
     else
@@ -554,7 +621,8 @@ int Vector3Keys::Vector3At(float frame, Vector3 &vec) {
     float ref = 0.0f;
     const Key<Vector3> *prev;
     const Key<Vector3> *next;
-    int idx = AtFrame(frame, prev, next, ref);
+    int cursor = mLastKeyFrameIndex;
+    int idx = AtFrame(frame, prev, next, ref, cursor);
     switch (mInterpolation) {
     case kNoException:
         vec = prev->value;
@@ -615,7 +683,8 @@ void Vector3Keys::SetFrame(float frame, float blend) {
 
 int SymbolKeys::SymbolAt(float frame, Symbol &sym) {
     MILO_ASSERT(size(), 0x322);
-    return AtFrame(frame, sym);
+    int cursor = mLastKeyFrameIndex;
+    return AtFrame(frame, sym, cursor);
 }
 
 void SymbolKeys::SetFrame(float frame, float blend) {
@@ -627,7 +696,8 @@ void SymbolKeys::SetFrame(float frame, float blend) {
         const Key<Symbol> *prev;
         const Key<Symbol> *next;
         float ref = 0.0f;
-        idx = AtFrame(frame, prev, next, ref);
+        int cursor = mLastKeyFrameIndex;
+        idx = AtFrame(frame, prev, next, ref, cursor);
         sInterpMessage.SetType(mInterpHandler);
         sInterpMessage[0] = prev->value;
         sInterpMessage[1] = next->value;
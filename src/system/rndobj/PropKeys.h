@@ -9,6 +9,9 @@
 #include "math/Key.h"
 #include "obj/Msg.h"
 
+class RndDrawable;
+class RndMat;
+
 /** Set PropKeys' internal rev value for saving/loading. */
 void SetPropKeysRev(int rev);
 
@@ -73,6 +76,18 @@ public:
         kMacro
     };
 
+    /** Direct setters a prop path can be compiled to, in place of SetProperty. */
+    enum BindingID {
+        /** Go through mTarget's SetProperty. */
+        kBindProperty,
+        /** RndDrawable's (showing) */
+        kBindShowing,
+        /** RndMat's (alpha) */
+        kBindMatAlpha,
+        /** RndMat's (color) */
+        kBindMatColor
+    };
+
     PropKeys(Hmx::Object *, Hmx::Object *);
     virtual ~PropKeys();
     virtual Hmx::Object *RefOwner() { return nullptr; }
@@ -214,6 +229,8 @@ public:
     void SetTarget(Hmx::Object *target);
     /** Set the prop exception ID. */
     void SetPropExceptionID();
+    /** Resolve mProp on mTarget to one of the direct setters, or to SetProperty. */
+    void Bind();
     /** Change the frame value of the keyframe at the supplied index.
      * @param [in] idx The index of the keyframe to modify.
      * @param [in] frame The new frame value.
@@ -229,9 +246,17 @@ public:
     void ResetLastKeyFrameIndex() { mLastKeyFrameIndex = -2; }
     Symbol InterpHandler() const { return mInterpHandler; }
     static unsigned int PropExceptionID(Hmx::Object *, DataArray *);
+    static BindingID PropBindingID(Hmx::Object *, DataArray *);
+
+    /** Push a value to mTarget's mProp, through the bound setter if there is one. */
+    void SetBoundProperty(float);
+    void SetBoundProperty(const Hmx::Color &);
+    void SetBoundProperty(bool);
 
     static unsigned short gRev;
     static Message sInterpMessage;
+    /** If false, Bind() leaves every path on SetProperty. */
+    static bool sBindProps;
 
     /** The target object to animate properties on. */
     ObjOwnerPtr<Hmx::Object> mTarget; // 0x4
@@ -240,7 +265,8 @@ public:
     RndTransformable *mTrans; // 0x14
     /** The handler name of any propagated interp messages. */
     Symbol mInterpHandler; // 0x18
-    /** The index of the last keyframe that was modified. */
+    /** The index of the last keyframe that was modified, which the next key search
+     * also starts from. */
     unsigned int mLastKeyFrameIndex : 22;
     /** The animation keys type. */
     unsigned int mKeysType : 3; // represents the enum AnimKeysType
@@ -248,6 +274,13 @@ public:
     unsigned int mInterpolation : 3; // represents the enum Interpolation
     unsigned int mPropExceptionID : 3; // represents the enum ExceptionID
     unsigned int unk18lastbit : 1;
+    /** The setter mProp is bound to, see BindingID. */
+    int mBinding; // 0x20
+    /** mTarget, cast to the class mBinding writes to. */
+    union {
+        RndDrawable *mBoundDraw;
+        RndMat *mBoundMat;
+    }; // 0x24
 };
 
 /** A collection of float keys to animate on its target object's properties. */
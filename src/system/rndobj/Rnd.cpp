@@ -58,6 +58,7 @@
 #include "rndobj/TexBlendController.h"
 #include "rndobj/TexBlender.h"
 #include "rndobj/TexRenderer.h"
+#include "rndobj/TexStreamer.h"
 #include "rndobj/Text.h"
 #include "rndobj/Trans.h"
 #include "rndobj/TransAnim.h"
@@ -336,6 +337,7 @@ void Rnd::PreInit() {
     DataRegisterFunc("keep_going", FailKeepGoing);
     DataRegisterFunc("restart_console", FailRestartConsole);
     RndUtlInit();
+    RndBitmapInit();
 }
 
 void Rnd::Init() {
@@ -347,6 +349,7 @@ void Rnd::Init() {
             SetShowTimers(true, true);
         }
     }
+    TheTexStreamer.Init();
 }
 
 void Rnd::Terminate() {
@@ -354,6 +357,7 @@ void Rnd::Terminate() {
     gpDbgFrameID = 0;
 #endif
     RELEASE(mConsole);
+    TheTexStreamer.Terminate();
     TheDebug.RemoveExitCallback(TerminateCallback);
     RndOverlay::Terminate();
     RndMultiMesh::Terminate();
@@ -399,6 +403,7 @@ void Rnd::BeginDrawing() {
         mPointTests.clear();
     }
     mDrawCount++;
+    TheTexStreamer.Poll();
     if (RndPostProc::Current()) {
         RndPostProc::Current()->SetBloomColor();
     }
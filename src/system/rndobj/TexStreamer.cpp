@@ -0,0 +1,510 @@
+#include "rndobj/TexStreamer.h"
+#include "math/Rot.h"
+#include "math/Utl.h"
+#include "obj/DataFunc.h"
+#include "os/Debug.h"
+#include "os/System.h"
+#include "os/Timer.h"
+#include "rndobj/Bitmap.h"
+#include "rndobj/Cam.h"
+#include "rndobj/Draw.h"
+#include "rndobj/Mat.h"
+#include "rndobj/Rnd.h"
+#include "rndobj/Utl.h"
+#include "utl/Loader.h"
+#include "utl/MemMgr.h"
+#include "utl/Std.h"
+#include <algorithm>
+
+RndTexStreamer TheTexStreamer;
+
+namespace {
+    // managed textures drop to their largest mip no bigger than this
+    const int kLowSize = 32;
+    // full loads in flight at once
+    const int kMaxLoads = 2;
+    // how long a simulated load takes
+    const int kSimLoadFrames = 4;
+    // frames a texture counts as drawn after its last request
+    const int kKeepFrames = 60;
+
+    // how many halvings bring w and h within kLowSize, or 0 if they can't or needn't
+    int LowShift(int w, int h) {
+        int shift = 0;
+        while ((w >> shift) > kLowSize || (h >> shift) > kLowSize)
+            shift++;
+        if ((w >> shift) < 4 || (h >> shift) < 4)
+            return 0;
+        return shift;
+    }
+
+    int BitmapBytes(const RndBitmap &bm) {
+        int bytes = 0;
+        for (const RndBitmap *b = &bm; b; b = b->nextMip()) {
+            bytes += b->RowBytes() * b->Height();
+        }
+        return bytes;
+    }
+
+    // whether ShrinkBitmap can read bm: linear rows, or plain DXT blocks.
+    // DxtColor doesn't know GX's tiled layouts, so those, CMPR included, can't
+    bool Shrinkable(const RndBitmap &bm) {
+        return bm.LinearRows() || ((bm.Order() & 0x38) && !(bm.Order() & 0x40));
+    }
+
+    // the DXT format ShrinkBitmap keeps for bm, if any
+    int LowDxt(const RndBitmap &bm, int w, int h) {
+        return (w | h) & 3 ? 0 : bm.Order() & 0x38;
+    }
+
+    // bytes of what ShrinkBitmap makes of bm
+    int LowBytes(const RndBitmap &bm, int shift) {
+        int w = bm.Width() >> shift;
+        int h = bm.Height() >> shift;
+        int dxt = LowDxt(bm, w, h);
+        if (dxt)
+            return dxt == RndBitmap::kDXT1 ? w * h / 2 : w * h;
+        return w * h * 4;
+    }
+
+    // box filters bm down by 1 << shift into low, back to DXT if it was
+    bool ShrinkBitmap(const RndBitmap &bm, int shift, RndBitmap &low) {
+        if (!Shrinkable(bm)) {
+            MILO_FAIL("Can't shrink a bitmap of order %d", bm.Order());
+            return false;
+        }
+        int w = bm.Width() >> shift;
+        int h = bm.Height() >> shift;
+        int f = 1 << shift;
+        int dxt = LowDxt(bm, w, h);
+        low.Create(w, h, 0, 32, 1, 0, 0, 0);
+        unsigned char *row = (unsigned char *)_MemAllocTemp(w * 4, 0);
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                int sum[4] = { 0, 0, 0, 0 };
+                for (int j = 0; j < f; j++) {
+                    for (int i = 0; i < f; i++) {
+                        unsigned char c[4];
+                        bm.PixelColor(x * f + i, y * f + j, c[0], c[1], c[2], c[3]);
+                        for (int ch = 0; ch < 4; ch++)
+                            sum[ch] += c[ch];
+                    }
+                }
+                for (int ch = 0; ch < 4; ch++)
+                    row[x * 4 + ch] = sum[ch] >> (shift * 2);
+            }
+            low.SetRowColors(0, y, w, row);
+        }
+        _MemFree(row);
+        if (dxt)
+            low.CompressDxt(dxt != RndBitmap::kDXT1);
+        return true;
+    }
+
+    bool SortWanted(
+        const std::pair<float, RndTex *> &p1, const std::pair<float, RndTex *> &p2
+    ) {
+        return p1.first > p2.first;
+    }
+}
+
+#ifdef MILO_DEBUG
+namespace {
+    // (bench_tex_stream textures size frames budget_kb) - flies a simulated camera
+    // down a corridor of textured spheres with a simulated streamer, and reports
+    // how well it holds the budget and how long draws wait for full textures
+    DataNode BenchTexStream(DataArray *a) {
+        int numTex = a->Size() > 1 ? a->Int(1) : 64;
+        int size = a->Size() > 2 ? a->Int(2) : 256;
+        int frames = a->Size() > 3 ? a->Int(3) : 600;
+        int budgetKb = a->Size() > 4 ? a->Int(4) : 1024;
+        RndTexStreamer streamer;
+        streamer.mSimulate = true;
+        streamer.mBudget = budgetKb * 1024;
+        std::vector<RndTex *> texs;
+        for (int i = 0; i < numTex; i++) {
+            RndTex *tex = Hmx::Object::New<RndTex>();
+            tex->mWidth = size;
+            tex->mHeight = size;
+            tex->mBpp = 4;
+            tex->mType = RndTex::kRegular;
+            texs.push_back(tex);
+        }
+        // spheres every 5 units down both walls, seen with a 60 degree fov
+        const float kSpacing = 5;
+        const float kRadius = 2;
+        float length = numTex / 2 * kSpacing;
+        float scale = 480 / (2 * std::tan(PI / 6));
+        int peak = 0;
+        int overFrames = 0;
+        int waits = 0;
+        Timer timer;
+        for (int f = 0; f < frames; f++) {
+            float eye = length * f / frames;
+            for (int i = 0; i < numTex; i++) {
+                Vector3 center((i & 1) ? 4 : -4, (i >> 1) * kSpacing, 0);
+                float ahead = center.y - eye;
+                if (ahead <= 0 || std::fabs(center.x) > ahead * 0.58f + kRadius)
+                    continue;
+                float d = std::sqrt(ahead * ahead + center.x * center.x);
+                float pixels = PI * (kRadius * scale / d) * (kRadius * scale / d);
+                streamer.Request(texs[i], pixels);
+                std::map<RndTex *, RndTexStreamer::Entry>::iterator it =
+                    streamer.mEntries.find(texs[i]);
+                if (it != streamer.mEntries.end() && pixels > it->second.mLowPixels
+                    && !it->second.mFull)
+                    waits++;
+            }
+            timer.Start();
+            streamer.Poll();
+            timer.Stop();
+            int resident = streamer.ResidentBytes();
+            MaxEq(peak, resident);
+            if (resident > streamer.mBudget)
+                overFrames++;
+        }
+        MILO_LOG(
+            "bench_tex_stream: %d textures of %dx%d, budget %d kb, peak %d kb, %d frames over, %d loads, %d evictions, %.1f frames to full, %d draws waiting, poll %.3f ms per frame\n",
+            numTex,
+            size,
+            size,
+            budgetKb,
+            peak / 1024,
+            overFrames,
+            streamer.mNumLoads,
+            streamer.mNumEvictions,
+            streamer.mNumLoads > 0
+                ? streamer.mLatencyFrames / (float)streamer.mNumLoads
+                : 0.0f,
+            waits,
+            frames > 0 ? timer.Ms() / frames : 0.0f
+        );
+        streamer.Terminate();
+        FOREACH (it, texs) {
+            delete *it;
+        }
+        return overFrames == 0;
+    }
+}
+#endif
+
+RndTexStreamer::RndTexStreamer()
+    : mBudget(0), mFrame(0), mLoading(0), mResident(0), mSimulate(false),
+      mNumLoads(0), mNumEvictions(0), mLatencyFrames(0) {}
+
+RndTexStreamer::~RndTexStreamer() { Terminate(); }
+
+void RndTexStreamer::Replace(Hmx::Object *from, Hmx::Object *to) {
+    RndTex *tex = static_cast<RndTex *>(from);
+    bool pinned = mPinned.erase(tex) != 0;
+    if (mEntries.find(tex) != mEntries.end())
+        Remove(tex);
+    else if (pinned)
+        tex->Release(this);
+}
+
+void RndTexStreamer::Init() {
+    DataArray *found = SystemConfig("rnd")->FindArray("texture_stream_kb", false);
+    mBudget = found ? found->Int(1) * 1024 : 0;
+#ifdef MILO_DEBUG
+    DataRegisterFunc("bench_tex_stream", BenchTexStream);
+#endif
+}
+
+void RndTexStreamer::Terminate() {
+    while (!mEntries.empty()) {
+        Remove(mEntries.begin()->first);
+    }
+    FOREACH (it, mPinned) {
+        (*it)->Release(this);
+    }
+    mPinned.clear();
+    mBudget = 0;
+    mResident = 0;
+}
+
+void RndTexStreamer::Add(RndTex *tex) {
+    if (LOADMGR_EDITMODE || tex->GetType() != RndTex::kRegular || tex->mLoader)
+        return;
+    if (mPinned.find(tex) != mPinned.end())
+        return;
+    int shift = LowShift(tex->Width(), tex->Height());
+    if (shift == 0)
+        return;
+    Entry e;
+    e.mFullBytes = (tex->Width() * tex->Height() * tex->Bpp()) >> 3;
+    e.mLowPixels = (tex->Width() >> shift) * (tex->Height() >> shift);
+    if (mSimulate)
+        e.mLowBytes = e.mFullBytes >> (shift * 2);
+    else {
+        if (tex->File().empty() || !tex->mBitmap.Pixels() || !Shrinkable(tex->mBitmap))
+            return;
+        e.mLowBytes = LowBytes(tex->mBitmap, shift);
+    }
+    Note(tex, e);
+    mEntries[tex] = e;
+    tex->AddRef(this);
+}
+
+void RndTexStreamer::Remove(RndTex *tex) {
+    std::map<RndTex *, Entry>::iterator it = mEntries.find(tex);
+    if (it == mEntries.end())
+        return;
+    if (Loading(it->second))
+        mLoading--;
+    delete it->second.mLoader;
+    mEntries.erase(it);
+    if (mPinned.find(tex) == mPinned.end())
+        tex->Release(this);
+}
+
+bool RndTexStreamer::Current(RndTex *tex, const Entry &e) const {
+    return tex->mBitmap.Pixels() == e.mBits && tex->Width() == e.mWidth
+        && tex->Height() == e.mHeight && !tex->mLoader;
+}
+
+void RndTexStreamer::Note(RndTex *tex, Entry &e) {
+    e.mBits = tex->mBitmap.Pixels();
+    e.mWidth = tex->Width();
+    e.mHeight = tex->Height();
+}
+
+void RndTexStreamer::Pin(RndTex *tex) {
+    if (!Enabled() || !mPinned.insert(tex).second)
+        return;
+    std::map<RndTex *, Entry>::iterator it = mEntries.find(tex);
+    if (it == mEntries.end()) {
+        tex->AddRef(this);
+        return;
+    }
+    Entry e = it->second;
+    if (e.mFull || mSimulate || !Current(tex, e)) {
+        Remove(tex);
+        return;
+    }
+    // small; finish its load, or load it now, before anything measures it
+    if (Loading(e))
+        mLoading--;
+    mEntries.erase(it);
+    if (!e.mLoader) {
+        e.mLoader = new FileLoader(
+            tex->File(),
+            CacheResource(tex->File().c_str(), tex),
+            kLoadFront,
+            0,
+            false,
+            true,
+            0
+        );
+    }
+    tex->mLoader = e.mLoader;
+    tex->SetBitmap(tex->mLoader);
+    tex->mLoader = nullptr;
+}
+
+void RndTexStreamer::Request(RndTex *tex, float pixels) {
+    if (!Enabled())
+        return;
+    std::map<RndTex *, Entry>::iterator it = mEntries.find(tex);
+    if (it != mEntries.end() && !Current(tex, it->second)) {
+        // something else set its bitmap; start over with that one
+        Remove(tex);
+        it = mEntries.end();
+    }
+    if (it == mEntries.end()) {
+        Add(tex);
+        it = mEntries.find(tex);
+        if (it == mEntries.end())
+            return;
+    }
+    Entry &e = it->second;
+    e.mLastFrame = mFrame;
+    MaxEq(e.mPixels, pixels);
+    if (!e.mFull && e.mWantFrame < 0 && pixels > e.mLowPixels)
+        e.mWantFrame = mFrame;
+}
+
+void RndTexStreamer::RequestVisible(const RndDrawList &list, RndCam *cam, int start) {
+    if (!Enabled())
+        return;
+    const Vector3 &eye = cam->WorldXfm().v;
+    float screen = TheRnd->Width() * TheRnd->Height();
+    // pixels across per unit of size at unit distance
+    float scale = TheRnd->Height() / (2 * std::tan(cam->YFov() / 2));
+    for (int i = start; i < list.Size(); i++) {
+        if (!list.Visible(i))
+            continue;
+        RndMat *mat = GetMat(list.mDraws[i]);
+        if (!mat || !mat->GetDiffuseTex())
+            continue;
+        float r = list.mR[i];
+        float pixels = screen;
+        if (r < kHugeFloat) {
+            Vector3 center(list.mX[i], list.mY[i], list.mZ[i]);
+            float d = Distance(center, eye);
+            if (d > r)
+                pixels = Min(screen, PI * (r * scale / d) * (r * scale / d));
+        }
+        Request(mat->GetDiffuseTex(), pixels);
+    }
+}
+
+void RndTexStreamer::Load(RndTex *tex, Entry &e) {
+    if (mSimulate)
+        e.mLoadFrame = mFrame + kSimLoadFrames;
+    else {
+        e.mLoader = new FileLoader(
+            tex->File(),
+            CacheResource(tex->File().c_str(), tex),
+            kLoadBack,
+            0,
+            false,
+            true,
+            0
+        );
+    }
+    mLoading++;
+}
+
+void RndTexStreamer::Promote(RndTex *tex, Entry &e) {
+    if (!mSimulate) {
+        tex->mLoader = e.mLoader;
+        tex->SetBitmap(tex->mLoader);
+        tex->mLoader = nullptr;
+        e.mLoader = nullptr;
+        Note(tex, e);
+    }
+    mLoading--;
+    e.mLoadFrame = -1;
+    e.mFull = true;
+    mNumLoads++;
+    if (e.mWantFrame >= 0)
+        mLatencyFrames += mFrame - e.mWantFrame;
+    e.mWantFrame = -1;
+}
+
+bool RndTexStreamer::Demote(RndTex *tex, Entry &e) {
+    if (!mSimulate) {
+        RndBitmap low;
+        if (!ShrinkBitmap(tex->mBitmap, LowShift(tex->Width(), tex->Height()), low))
+            return false;
+        // SetBitmap forgets the file, which the full load needs back
+        FilePath file = tex->File();
+        tex->SetBitmap(low, nullptr, true);
+        tex->mFilepath = file;
+        e.mLowBytes = BitmapBytes(tex->mBitmap);
+        Note(tex, e);
+    }
+    e.mFull = false;
+    mNumEvictions++;
+    return true;
+}
+
+bool RndTexStreamer::Recent(const Entry &e) const {
+    return mFrame - e.mLastFrame < kKeepFrames;
+}
+
+// shrinks the smallest on screen of the full textures requested lately that
+// aren't drawn at least pixels big this frame, the least recently drawn of
+// those that tie
+bool RndTexStreamer::EvictOne(float pixels, int &resident) {
+    RndTex *smallest = nullptr;
+    Entry *smallestEntry = nullptr;
+    FOREACH (it, mEntries) {
+        Entry &e = it->second;
+        if (!e.mFull || Loading(e) || !Recent(e) || e.mPixels >= pixels)
+            continue;
+        if (!smallestEntry || e.mPixels < smallestEntry->mPixels
+            || (e.mPixels == smallestEntry->mPixels
+                && e.mLastFrame < smallestEntry->mLastFrame)) {
+            smallest = it->first;
+            smallestEntry = &e;
+        }
+    }
+    if (!smallest)
+        return false;
+    if (Demote(smallest, *smallestEntry))
+        resident -= smallestEntry->mFullBytes - smallestEntry->mLowBytes;
+    else {
+        resident -= smallestEntry->mFullBytes;
+        Remove(smallest);
+    }
+    return true;
+}
+
+int RndTexStreamer::CountResident() const {
+    int bytes = 0;
+    FOREACH (it, mEntries) {
+        const Entry &e = it->second;
+        if (Recent(e))
+            bytes += e.mFull || Loading(e) ? e.mFullBytes : e.mLowBytes;
+    }
+    return bytes;
+}
+
+void RndTexStreamer::Poll() {
+    if (!Enabled())
+        return;
+    std::vector<RndTex *> done;
+    FOREACH (it, mEntries) {
+        const Entry &e = it->second;
+        if (!Current(it->first, e))
+            done.push_back(it->first);
+    }
+    FOREACH (it, done) {
+        Remove(*it);
+    }
+    done.clear();
+    FOREACH (it, mEntries) {
+        Entry &e = it->second;
+        if (mSimulate ? e.mLoadFrame >= 0 && mFrame >= e.mLoadFrame
+                      : e.mLoader && e.mLoader->IsLoaded())
+            Promote(it->first, e);
+        // full and not drawn lately; nothing left to manage
+        if (e.mFull && !Loading(e) && !Recent(e))
+            done.push_back(it->first);
+    }
+    FOREACH (it, done) {
+        Remove(*it);
+    }
+    // the textures drawn bigger than their small copy this frame, biggest first
+    std::vector<std::pair<float, RndTex *> > wanted;
+    // and the small ones no longer requested, which may still be drawn elsewhere
+    std::vector<RndTex *> returning;
+    FOREACH (it, mEntries) {
+        const Entry &e = it->second;
+        if (e.mFull || Loading(e))
+            continue;
+        if (!Recent(e))
+            returning.push_back(it->first);
+        else if (e.mLastFrame == mFrame && e.mPixels > e.mLowPixels)
+            wanted.push_back(std::make_pair(e.mPixels, it->first));
+    }
+    std::sort(wanted.begin(), wanted.end(), SortWanted);
+    int resident = CountResident();
+    FOREACH (it, wanted) {
+        if (mLoading >= kMaxLoads)
+            break;
+        Entry &e = mEntries[it->second];
+        int more = e.mFullBytes - e.mLowBytes;
+        while (resident + more > mBudget && EvictOne(e.mPixels, resident))
+            ;
+        if (resident + more > mBudget)
+            continue;
+        Load(it->second, e);
+        resident += more;
+    }
+    FOREACH (it, returning) {
+        if (mLoading >= kMaxLoads)
+            break;
+        Load(*it, mEntries[*it]);
+    }
+    // in case the budget shrank
+    while (resident > mBudget && EvictOne(kHugeFloat, resident))
+        ;
+    mResident = resident;
+    FOREACH (it, mEntries) {
+        it->second.mPixels = 0;
+    }
+    mFrame++;
+}
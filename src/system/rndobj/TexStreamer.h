@@ -0,0 +1,116 @@
+#pragma once
+#include "obj/Object.h"
+#include "rndobj/Tex.h"
+#include <map>
+#include <set>
+
+class RndCam;
+class RndDrawList;
+
+/**
+ * @brief Keeps file textures within a memory budget.
+ *
+ * Group draws request the diffuse textures of what they cull in, and only
+ * textures they keep requesting are managed. When the budget needs the memory,
+ * the smallest on screen drop to a small copy of their bitmap, and load in full
+ * again in the background once something draws them bigger than that copy,
+ * biggest on screen first. A small texture that stops being requested loads in
+ * full again too, since other draw paths may still use it.
+ *
+ * Only linear bitmaps and plain DXT shrink; GX-tiled ones, CMPR included, are
+ * never managed. Off unless rnd's texture_stream_kb config is set.
+ */
+class RndTexStreamer : public ObjRef {
+public:
+    struct Entry {
+        Entry()
+            : mLoader(0), mBits(0), mWidth(0), mHeight(0), mFullBytes(0),
+              mLowBytes(0), mLowPixels(0), mLastFrame(-1), mWantFrame(-1),
+              mLoadFrame(-1), mPixels(0), mFull(true) {}
+
+        /** The full bitmap's load, while it's in flight. */
+        FileLoader *mLoader; // 0x0
+        /** The texture's pixels and size as last seen, to notice other bitmaps
+         * going in.
+         */
+        void *mBits; // 0x4
+        int mWidth; // 0x8
+        int mHeight; // 0xc
+        int mFullBytes; // 0x10
+        int mLowBytes; // 0x14
+        /** Texels in the small copy; draws no bigger than this don't need the full. */
+        int mLowPixels; // 0x18
+        /** The frame the texture was last requested in. */
+        int mLastFrame; // 0x1c
+        /** The frame it was first wanted in full, while it isn't. */
+        int mWantFrame; // 0x20
+        /** The frame a simulated load finishes in. */
+        int mLoadFrame; // 0x24
+        /** The largest screen size requested this frame, in pixels. */
+        float mPixels; // 0x28
+        bool mFull; // 0x2c
+    };
+
+    RndTexStreamer();
+    virtual ~RndTexStreamer();
+    virtual Hmx::Object *RefOwner() { return nullptr; }
+    virtual void Replace(Hmx::Object *from, Hmx::Object *to);
+
+    /** Read the budget from rnd's config. */
+    void Init();
+    void Terminate();
+    bool Enabled() const { return mBudget > 0; }
+    /** Keep tex out of streaming for good, back at full size first if it was
+     * small. For textures whose size other objects measure, like font pages.
+     */
+    void Pin(RndTex *tex);
+    /** Note that tex is drawn over about this many pixels this frame, managing
+     * it if it's a file texture that can shrink.
+     */
+    void Request(RndTex *tex, float pixels);
+    /** Request the diffuse textures of list's visible draws from start on. */
+    void RequestVisible(const RndDrawList &list, RndCam *cam, int start);
+    /** Finish loads, evict and start loads for the last frame's requests. */
+    void Poll();
+    /** Bytes of the textures requested lately as of the last Poll, counting
+     * textures in flight as full.
+     */
+    int ResidentBytes() const { return mResident; }
+
+    std::map<RndTex *, Entry> mEntries; // 0x4
+    int mBudget; // 0x1c
+    int mFrame; // 0x20
+    int mLoading; // 0x24
+    int mResident; // 0x28
+    /** Account for loads and evictions without touching any bitmaps or files. */
+    bool mSimulate; // 0x2c
+    int mNumLoads; // 0x30
+    int mNumEvictions; // 0x34
+    /** Frames from wanted to full, summed over mNumLoads. */
+    int mLatencyFrames; // 0x38
+    std::set<RndTex *> mPinned; // 0x3c
+
+private:
+    RndTexStreamer(const RndTexStreamer &);
+    RndTexStreamer &operator=(const RndTexStreamer &);
+
+    void Add(RndTex *tex);
+    /** Stop managing tex, leaving whatever bitmap it has. */
+    void Remove(RndTex *tex);
+    /** Whether tex still has the bitmap e last saw. */
+    bool Current(RndTex *tex, const Entry &e) const;
+    void Note(RndTex *tex, Entry &e);
+    /** Start loading tex's full bitmap in the background. */
+    void Load(RndTex *tex, Entry &e);
+    void Promote(RndTex *tex, Entry &e);
+    bool Demote(RndTex *tex, Entry &e);
+    /** Whether e was requested lately enough to count against the budget. */
+    bool Recent(const Entry &e) const;
+    bool EvictOne(float pixels, int &resident);
+    int CountResident() const;
+    bool Loading(const Entry &e) const {
+        return mSimulate ? e.mLoadFrame >= 0 : e.mLoader != 0;
+    }
+};
+
+extern RndTexStreamer TheTexStreamer;
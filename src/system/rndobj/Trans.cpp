@@ -1,6 +1,8 @@
 #include "rndobj/Trans.h"
 #include "math/Rot.h"
+#include "math/Utl.h"
 #include "obj/Data.h"
+#include "obj/DataFunc.h"
 #include "obj/Dir.h"
 #include "obj/ObjMacros.h"
 #include "obj/ObjPtr_p.h"
@@ -17,8 +19,67 @@
 INIT_REVS(RndTransformable)
 Plane RndTransformable::sShadowPlane;
 
+#ifdef MILO_DEBUG
+// (bench_world_xfms root passes) - dirties everything under root and reads each
+// world xfm back leaves first, then does the same with one RndTransList pass,
+// and reports any xfms that disagree
+static DataNode OnBenchWorldXfms(DataArray *a) {
+    RndTransformable *root = a->Obj<RndTransformable>(1);
+    int passes = a->Size() > 2 ? a->Int(2) : 100;
+    RndTransList list;
+    list.SetRoot(root);
+    list.Build();
+    int count = list.Size();
+    int maxDepth = 0;
+    FOREACH (it, list.mTrans) {
+        int depth = 0;
+        for (RndTransformable *t = *it; t != root; t = t->TransParent()) {
+            depth++;
+        }
+        MaxEq(maxDepth, depth);
+    }
+    Timer timers[2];
+    for (int i = 0; i < passes; i++) {
+        root->SetDirty();
+        timers[0].Start();
+        // leaves first, the way skinning and attachments tend to ask
+        for (int j = count - 1; j >= 0; j--) {
+            list.mTrans[j]->WorldXfm();
+        }
+        timers[0].Stop();
+    }
+    std::vector<Transform> lazy(count);
+    for (int i = 0; i < count; i++) {
+        lazy[i] = list.mTrans[i]->mWorldXfm;
+    }
+    for (int i = 0; i < passes; i++) {
+        root->SetDirty();
+        timers[1].Start();
+        list.Update();
+        timers[1].Stop();
+    }
+    int mismatches = 0;
+    for (int i = 0; i < count; i++) {
+        if (!(list.mTrans[i]->mWorldXfm == lazy[i]))
+            mismatches++;
+    }
+    MILO_LOG(
+        "bench_world_xfms: %d trans, depth %d, on demand %.3f ms, one pass %.3f ms per update, %d mismatches\n",
+        count,
+        maxDepth,
+        passes > 0 ? timers[0].Ms() / passes : 0.0f,
+        passes > 0 ? timers[1].Ms() / passes : 0.0f,
+        mismatches
+    );
+    return mismatches == 0;
+}
+#endif
+
 void RndTransformable::Init() {
     Register();
+#ifdef MILO_DEBUG
+    DataRegisterFunc("bench_world_xfms", OnBenchWorldXfms);
+#endif
     DataArray *cfg = SystemConfig("rnd");
     cfg->FindData("shadow_plane", sShadowPlane, true);
 }
@@ -32,6 +93,8 @@ RndTransformable::RndTransformable()
 }
 
 RndTransformable::~RndTransformable() {
+    if (mParent || !mChildren.empty())
+        RndTransList::HierarchyChanged(this);
     if (mParent) {
         RemoveSwap(mParent->mChildren, this);
         RemoveSwap(mParent->mCache->mChildren, mCache);
@@ -75,10 +138,12 @@ void RndTransformable::SetTransParent(RndTransformable *newParent, bool recalcLo
             TransformTransAnims(tf78);
         }
         if (mParent) {
+            RndTransList::HierarchyChanged(mParent);
             RemoveSwap(mParent->mChildren, this);
             RemoveSwap(mParent->mCache->mChildren, mCache);
         }
         mParent = newParent;
+        RndTransList::HierarchyChanged(this);
         unsigned int newflags = newParent ? (unsigned int)newParent->mCache : 0;
         mCache->Set(newflags);
         if (newParent) {
@@ -144,6 +209,61 @@ Transform &RndTransformable::WorldXfm_Force() {
     return mWorldXfm;
 }
 
+bool RndTransList::sBatchUpdate = true;
+
+namespace {
+    // every list with a root, so a parent change only rebuilds the lists above it
+    std::vector<RndTransList *> gTransLists;
+}
+
+RndTransList::~RndTransList() { SetRoot(nullptr); }
+
+void RndTransList::SetRoot(RndTransformable *root) {
+    if (mRoot)
+        RemoveSwap(gTransLists, this);
+    mRoot = root;
+    mBuilt = false;
+    if (mRoot)
+        gTransLists.push_back(this);
+}
+
+void RndTransList::HierarchyChanged(RndTransformable *t) {
+    for (; t != nullptr; t = t->TransParent()) {
+        FOREACH (it, gTransLists) {
+            if ((*it)->mRoot == t)
+                (*it)->mBuilt = false;
+        }
+    }
+}
+
+void RndTransList::Build() {
+    mTrans.clear();
+    if (mRoot)
+        mTrans.push_back(mRoot);
+    for (int i = 0; i < (int)mTrans.size(); i++) {
+        const std::vector<RndTransformable *> &children = mTrans[i]->mChildren;
+        mTrans.insert(mTrans.end(), children.begin(), children.end());
+    }
+    mBuilt = true;
+}
+
+void RndTransList::Update() {
+    START_AUTO_TIMER("updateworldxfms");
+    if (!mBuilt)
+        Build();
+    FOREACH (it, mTrans) {
+        RndTransformable *t = *it;
+        if (!t->Dirty())
+            continue;
+        // constraints follow targets that may not be posed yet, so leave them and
+        // everything under them to work out on demand; parents come first, so a
+        // parent still dirty here is one of those
+        if (t->HasDynamicConstraint() || (t != mRoot && t->TransParent()->Dirty()))
+            continue;
+        t->WorldXfm_Force();
+    }
+}
+
 void RndTransformable::ApplyDynamicConstraint() {
     if (mConstraint == kTargetWorld) {
         mWorldXfm = mTarget->WorldXfm();
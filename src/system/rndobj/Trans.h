@@ -200,6 +200,40 @@ public:
     DELETE_OVERLOAD
 };
 
+/**
+ * @brief The transformables under a root, flattened for one update pass.
+ *
+ * Keeps the hierarchy in breadth first order, so every parent comes before
+ * its children and refreshing each dirty world xfm in order never has to
+ * recurse up to an ancestor. Rebuilds itself whenever a parent link under
+ * its root has changed since it was built. The root must outlive the list.
+ */
+class RndTransList {
+public:
+    RndTransList() : mRoot(nullptr), mBuilt(false) {}
+    ~RndTransList();
+    void SetRoot(RndTransformable *root);
+    /** Recompute every dirty world xfm under the root, parents first. Anything
+     * with a dynamic constraint, and everything under it, is left dirty. */
+    void Update();
+    void Build();
+    int Size() const { return mTrans.size(); }
+
+    /** Rebuild the lists rooted at t or any of its ancestors. */
+    static void HierarchyChanged(RndTransformable *t);
+
+    RndTransformable *mRoot; // 0x0
+    std::vector<RndTransformable *> mTrans; // 0x4
+    bool mBuilt; // 0x10
+
+    /** Whether owners refresh their hierarchy in one pass each poll. */
+    static bool sBatchUpdate;
+
+private:
+    RndTransList(const RndTransList &);
+    RndTransList &operator=(const RndTransList &);
+};
+
 class RndTransformableRemover : public RndTransformable {
 public:
     RndTransformableRemover() {}
@@ -4,6 +4,7 @@
 #include "math/Rot.h"
 #include "obj/ObjMacros.h"
 #include "os/Debug.h"
+#include "os/Timer.h"
 #include "rndobj/Anim.h"
 #include "rndobj/Draw.h"
 #include "rndobj/Utl.h"
@@ -14,7 +15,9 @@ static int TRANSANIM_REV = 7;
 RndTransAnim::RndTransAnim()
     : mTrans(this), mTransSpline(0), mScaleSpline(0), mRotSlerp(0), mRotSpline(0),
       mRotKeys(), mTransKeys(), mScaleKeys(), mKeysOwner(this, this), mRepeatTrans(0),
-      mFollowPath(0) {}
+      mFollowPath(0) {
+    mCursors[0] = mCursors[1] = mCursors[2] = -1;
+}
 
 void RndTransAnim::SetTrans(RndTransformable *trans) { mTrans = trans; }
 
@@ -172,9 +175,15 @@ float RndTransAnim::StartFrame() {
 
 // matches in retail with the right inline settings: https://decomp.me/scratch/vtXKh
 void RndTransAnim::MakeTransform(float frame, Transform &tf, bool whole, float blend) {
+    MakeTransform(frame, tf, whole, blend, mCursors);
+}
+
+void RndTransAnim::MakeTransform(
+    float frame, Transform &tf, bool whole, float blend, int *cursors
+) {
     float f5 = frame;
     if (mKeysOwner != this) {
-        mKeysOwner->MakeTransform(frame, tf, whole, blend);
+        mKeysOwner->MakeTransform(frame, tf, whole, blend, cursors);
     } else {
         Vector3 v4c;
         if (!mTransKeys.empty()) {
@@ -192,7 +201,12 @@ void RndTransAnim::MakeTransform(float frame, Transform &tf, bool whole, float b
             if (blend != 1.0f) {
                 Vector3 v64;
                 InterpVector(
-                    mTransKeys, mTransSpline, f5, v64, mFollowPath ? &v4c : nullptr
+                    mTransKeys,
+                    mTransSpline,
+                    f5,
+                    v64,
+                    mFollowPath ? &v4c : nullptr,
+                    cursors[1]
                 );
                 if (mRepeatTrans) {
                     ::Add(v64, v58, v64);
@@ -200,7 +214,12 @@ void RndTransAnim::MakeTransform(float frame, Transform &tf, bool whole, float b
                 Interp(tf.v, v64, blend, tf.v);
             } else {
                 InterpVector(
-                    mTransKeys, mTransSpline, f5, tf.v, mFollowPath ? &v4c : nullptr
+                    mTransKeys,
+                    mTransSpline,
+                    f5,
+                    tf.v,
+                    mFollowPath ? &v4c : nullptr,
+                    cursors[1]
                 );
                 if (mRepeatTrans) {
                     ::Add(tf.v, v58, tf.v);
@@ -215,7 +234,7 @@ void RndTransAnim::MakeTransform(float frame, Transform &tf, bool whole, float b
             const Key<Hmx::Quat> *prev;
             const Key<Hmx::Quat> *next;
             float ref = 0;
-            mRotKeys.AtFrame(f5, prev, next, ref);
+            mRotKeys.AtFrame(f5, prev, next, ref, cursors[0]);
             if (mRotSpline)
                 QuatSpline(mRotKeys, prev, next, ref, q80);
             else {
@@ -251,7 +270,7 @@ void RndTransAnim::MakeTransform(float frame, Transform &tf, bool whole, float b
         }
         if (!mScaleKeys.empty()) {
             Vector3 v9c;
-            InterpVector(mScaleKeys, mScaleSpline, f5, v9c, 0);
+            InterpVector(mScaleKeys, mScaleSpline, f5, v9c, 0, cursors[2]);
             if (blend != 1.0f) {
                 Interp(v70, v9c, blend, v9c);
             }
@@ -387,3 +406,89 @@ BEGIN_PROPSYNCS(RndTransAnim)
     SYNC_PROP_SET(keys_owner, mKeysOwner, SetKeysOwner(_val.Obj<RndTransAnim>()))
     SYNC_SUPERCLASS(RndAnimatable)
 END_PROPSYNCS
+
+#ifdef MILO_DEBUG
+// (bench_key_cursor keys steps) - sweeps a track of that many keys forward, steps
+// evaluations per key, with a bisection per evaluation, with a cursor, and with
+// AtFrames over 8 channels keyed together; checks the cursor lands the same
+static DataNode OnBenchKeyCursor(DataArray *a) {
+    int numKeys = a->Size() > 1 ? a->Int(1) : 2000;
+    int steps = a->Size() > 2 ? a->Int(2) : 4;
+    const int kChannels = 8;
+    Keys<Vector3, Vector3> pos;
+    Keys<float, float> channels[kChannels];
+    for (int i = 0; i < numKeys; i++) {
+        pos.push_back(Key<Vector3>(Vector3(i, i * 2, i * 3), i));
+        for (int c = 0; c < kChannels; c++) {
+            channels[c].push_back(Key<float>(i + c, i));
+        }
+    }
+    int numEvals = numKeys * steps;
+    float dFrame = 1.0f / steps;
+    Timer timers[4];
+    Vector3 plain;
+    Vector3 cursored;
+    int cursor = -1;
+    timers[0].Start();
+    for (int i = 0; i < numEvals; i++) {
+        InterpVector(pos, false, i * dFrame, plain, nullptr);
+    }
+    timers[0].Stop();
+    timers[1].Start();
+    for (int i = 0; i < numEvals; i++) {
+        InterpVector(pos, false, i * dFrame, cursored, nullptr, cursor);
+    }
+    timers[1].Stop();
+    // and once more untimed, backwards too, against the bisection
+    int mismatches = 0;
+    for (int i = -numEvals; i < numEvals; i++) {
+        float frame = (i < 0 ? -i : i) * dFrame;
+        InterpVector(pos, false, frame, plain, nullptr);
+        InterpVector(pos, false, frame, cursored, nullptr, cursor);
+        if (plain != cursored)
+            mismatches++;
+    }
+    const Keys<float, float> *tracks[kChannels];
+    int cursors[kChannels];
+    float vals[kChannels];
+    for (int c = 0; c < kChannels; c++) {
+        tracks[c] = &channels[c];
+        cursors[c] = -1;
+    }
+    timers[2].Start();
+    for (int i = 0; i < numEvals; i++) {
+        for (int c = 0; c < kChannels; c++) {
+            channels[c].AtFrame(i * dFrame, vals[c]);
+        }
+    }
+    timers[2].Stop();
+    timers[3].Start();
+    for (int i = 0; i < numEvals; i++) {
+        AtFrames(tracks, kChannels, i * dFrame, cursors, vals);
+    }
+    timers[3].Stop();
+    int evals[4] = { numEvals, numEvals, numEvals * kChannels, numEvals * kChannels };
+    const char *names[4] = { "bisect", "cursor", "bisect x8", "AtFrames x8" };
+    for (int i = 0; i < 4; i++) {
+        MILO_LOG(
+            "bench_key_cursor: %s, %.0f evals/s\n",
+            names[i],
+            timers[i].Ms() > 0 ? evals[i] * 1000.0f / timers[i].Ms() : 0.0f
+        );
+    }
+    MILO_LOG(
+        "bench_key_cursor: %d keys, %d evals, %d mismatches\n",
+        numKeys,
+        numEvals,
+        mismatches
+    );
+    return mismatches == 0;
+}
+#endif
+
+void RndTransAnim::Init() {
+    REGISTER_OBJ_FACTORY(RndTransAnim)
+#ifdef MILO_DEBUG
+    DataRegisterFunc("bench_key_cursor", OnBenchKeyCursor);
+#endif
+}
@@ -30,6 +30,8 @@ public:
     virtual void Print();
 
     void MakeTransform(float frame, Transform &tf, bool whole, float blend);
+    /** MakeTransform, searching from the given rot, trans and scale key cursors. */
+    void MakeTransform(float frame, Transform &tf, bool whole, float blend, int *cursors);
 
     // getters and setters
     void SetTrans(RndTransformable *);
@@ -143,7 +145,7 @@ public:
     NEW_OVERLOAD;
     DELETE_OVERLOAD;
     NEW_OBJ(RndTransAnim)
-    static void Init() { REGISTER_OBJ_FACTORY(RndTransAnim) }
+    static void Init();
 
     /** The Trans to animate. */
     ObjPtr<RndTransformable> mTrans; // 0x10
@@ -165,4 +167,7 @@ public:
     ObjOwnerPtr<RndTransAnim> mKeysOwner; // 0x38
     bool mRepeatTrans; // 0x44
     bool mFollowPath; // 0x45
+    /** Where this anim's last evaluation landed in the rot, trans and scale keys,
+     * which may be mKeysOwner's, for the next search to start from. */
+    int mCursors[3]; // 0x48
 };
@@ -39,6 +39,7 @@
 #include "rndobj/MultiMesh.h"
 #include "rndobj/Part.h"
 #include "rndobj/PartAnim.h"
+#include "rndobj/PollSafe.h"
 #include "rndobj/Rnd.h"
 #include "rndobj/Tex.h"
 #include "rndobj/Text.h"
@@ -48,7 +49,10 @@
 #include "math/Key.h"
 #include "utl/Std.h"
 #include "utl/ClassSymbols.h"
+#include <algorithm>
 #include <cmath>
+#include <list>
+#include <set>
 
 typedef void (*SplashFunc)(void);
 
@@ -174,6 +178,59 @@ bool SortPolls(const RndPollable *p1, const RndPollable *p2) {
         return strcmp(p1->Name(), p2->Name()) < 0;
 }
 
+namespace {
+    bool
+    Touches(const std::list<Hmx::Object *> &objs, const std::set<Hmx::Object *> &set) {
+        FOREACH (it, objs) {
+            if (set.find(*it) != set.end())
+                return true;
+        }
+        return false;
+    }
+
+    bool SortPollClasses(const RndPollable *p1, const RndPollable *p2) {
+        return strcmp(p1->ClassName().Str(), p2->ClassName().Str()) < 0;
+    }
+}
+
+// Splits polls, sorted by SortPolls, into waves: each pollable that isn't an
+// RndPollSafe is a wave of its own, and runs of RndPollSafe ones whose declared
+// objects don't overlap share one. Each shared wave is regrouped class by class so
+// the same Poll code runs back to back. Returns the number of waves.
+int SchedulePolls(std::vector<RndPollable *> &polls) {
+    int waves = 0;
+    std::vector<RndPollable *>::iterator waveStart = polls.begin();
+    std::set<Hmx::Object *> reads;
+    std::set<Hmx::Object *> writes;
+    std::list<Hmx::Object *> pollReads;
+    std::list<Hmx::Object *> pollWrites;
+    for (std::vector<RndPollable *>::iterator it = polls.begin(); it != polls.end();
+         ++it) {
+        RndPollSafe *safe = dynamic_cast<RndPollSafe *>(*it);
+        if (safe) {
+            pollReads.clear();
+            pollWrites.clear();
+            safe->ListPollDeps(pollReads, pollWrites);
+            if (it == waveStart || Touches(pollReads, writes)
+                || Touches(pollWrites, writes) || Touches(pollWrites, reads)) {
+                std::stable_sort(waveStart, it, SortPollClasses);
+                waveStart = it;
+                reads.clear();
+                writes.clear();
+                waves++;
+            }
+            reads.insert(pollReads.begin(), pollReads.end());
+            writes.insert(pollWrites.begin(), pollWrites.end());
+        } else {
+            std::stable_sort(waveStart, it, SortPollClasses);
+            waveStart = it + 1;
+            waves++;
+        }
+    }
+    std::stable_sort(waveStart, polls.end(), SortPollClasses);
+    return waves;
+}
+
 // matches in retail with the right inline settings: https://decomp.me/scratch/9OmqG
 void CalcBox(RndMesh *m, Box &b) {
     for (RndMesh::Vert *it = m->Verts().begin(); it != m->Verts().end(); ++it) {
@@ -39,6 +39,7 @@ const char *CacheResource(const char *, Hmx::Object *);
 const char *CacheResource(const char *, CacheResourceResult &);
 bool SortDraws(RndDrawable *, RndDrawable *);
 bool SortPolls(const RndPollable *, const RndPollable *);
+int SchedulePolls(std::vector<RndPollable *> &);
 void SetRndSplasherCallback(void (*)(void), void (*)(void), void (*)(void));
 void ConvertBonesToTranses(ObjectDir *, bool);
 int GenerationCount(RndTransformable *, RndTransformable *);
@@ -370,6 +370,25 @@ int Spotlight::CollidePlane(const Plane &pl) {
     return -1;
 }
 
+// aims at its targets and moves its beam and slave lights to match
+void Spotlight::ListPollDeps(
+    std::list<Hmx::Object *> &reads, std::list<Hmx::Object *> &writes
+) const {
+    for (RndTransformable *t = TransParent(); t; t = t->TransParent()) {
+        reads.push_back(t);
+    }
+    if (mTarget)
+        reads.push_back(mTarget);
+    if (mSpotTarget)
+        reads.push_back(mSpotTarget);
+    writes.push_back(const_cast<Spotlight *>(this));
+    if (mBeam.mBeam)
+        writes.push_back(mBeam.mBeam);
+    FOREACH (it, mSlaves) {
+        writes.push_back(*it);
+    }
+}
+
 void Spotlight::Poll() {
     if (!LOADMGR_EDITMODE) {
         if (!Showing())
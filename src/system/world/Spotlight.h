@@ -2,6 +2,7 @@
 #include "rndobj/Draw.h"
 #include "rndobj/Trans.h"
 #include "rndobj/Poll.h"
+#include "rndobj/PollSafe.h"
 #include "rndobj/Env.h"
 
 class RndGroup;
@@ -11,7 +12,10 @@ class RndTex;
 class RndLight;
 
 /** "Represents a beam and floorspot for venue modeling" */
-class Spotlight : public RndDrawable, public RndTransformable, public RndPollable {
+class Spotlight : public RndDrawable,
+                  public RndTransformable,
+                  public RndPollable,
+                  public RndPollSafe {
 public:
     class BeamDef {
     public:
@@ -88,6 +92,8 @@ public:
 
     virtual void UpdateBounds();
     virtual void Poll();
+    virtual void ListPollDeps(std::list<Hmx::Object *> &, std::list<Hmx::Object *> &)
+        const;
     virtual void Replace(Hmx::Object *, Hmx::Object *);
 
     void BuildNGCone(BeamDef &, int);